@@ -0,0 +1,434 @@
+/**
+ * @file    benchmarks/bench.cpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the benchmarks of the algebraic specializations, each paired with a raw baseline.
+ * @date    2023-11-18
+ * @copyright Copyright (c) 2023
+ */
+
+
+#include <benchmark/benchmark.h>
+
+#include "ctda.hpp"
+
+using namespace ctda;
+using namespace units;
+
+
+using column = std::vector<double>;
+
+/// sizes of the vector benchmarks, from L1 to DRAM resident operands
+#define CTDA_BENCH_SIZES RangeMultiplier(16)->Range(1 << 8, 1 << 22)
+
+
+/// @brief Set the throughput counters: 'streams' arrays of n doubles are read or written per iteration.
+static void set_bytes(benchmark::State& state, size_t n, size_t streams) {
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n * streams * sizeof(double)));
+
+}
+
+
+/// @brief Column of n pseudo-random values in [1, 2)
+static column make_column(size_t n, unsigned seed) {
+
+    column x(n);
+    for (size_t i = 0; i < n; ++i)
+        x[i] = 1.0 + static_cast<double>((i * 2654435761u + seed) % 1000) / 1000.0;
+    return x;
+
+}
+
+
+// ---------------------------------------------------------------------------------------------
+// scalars
+// ---------------------------------------------------------------------------------------------
+
+static void scalar_raw(benchmark::State& state) {
+
+    double a = 1.5, b = 2.5, c = 0.5;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        double r = (a + b) * c / b - a;
+        benchmark::DoNotOptimize(r);
+    }
+    set_bytes(state, 1, 4);
+
+}
+BENCHMARK(scalar_raw);
+
+static void scalar_quantity(benchmark::State& state) {
+
+    auto a = quantity<double, meter>(1.5);
+    auto b = quantity<double, meter>(2.5);
+    auto c = quantity<double, second>(0.5);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        auto r = (a + b) * c / b - c;
+        benchmark::DoNotOptimize(r);
+    }
+    set_bytes(state, 1, 4);
+
+}
+BENCHMARK(scalar_quantity);
+
+static void scalar_converted_quantity(benchmark::State& state) {
+
+    auto a = quantity<double, meter>(1.5);
+    auto b = quantity<double, unit<basis::length, std::milli>>(2500.0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        auto r = a + b;
+        benchmark::DoNotOptimize(r);
+    }
+    set_bytes(state, 1, 3);
+
+}
+BENCHMARK(scalar_converted_quantity);
+
+
+static void complex_raw(benchmark::State& state) {
+
+    std::complex<double> a{1.5, 0.5}, b{2.5, -0.5};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        auto r = (a + b) * a - b / a;
+        benchmark::DoNotOptimize(r);
+    }
+    set_bytes(state, 2, 3);
+
+}
+BENCHMARK(complex_raw);
+
+static void complex_ctda(benchmark::State& state) {
+
+    std::complex<double> a{1.5, 0.5}, b{2.5, -0.5};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        auto r = math::sub(math::mult(math::add(a, b), a), math::div(b, a));
+        benchmark::DoNotOptimize(r);
+    }
+    set_bytes(state, 2, 3);
+
+}
+BENCHMARK(complex_ctda);
+
+
+static void measurement_raw(benchmark::State& state) {
+
+    double xv = 3.0, xu = 0.1, yv = 2.0, yu = 0.05;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(xv);
+        benchmark::DoNotOptimize(yv);
+        double v = xv * yv;
+        double u = std::sqrt(xu * yv * xu * yv + xv * yu * xv * yu);
+        benchmark::DoNotOptimize(v);
+        benchmark::DoNotOptimize(u);
+    }
+    set_bytes(state, 2, 3);
+
+}
+BENCHMARK(measurement_raw);
+
+static void measurement_ctda(benchmark::State& state) {
+
+    auto x = measurement<quantity<double, meter>>(3.0, 0.1);
+    auto y = measurement<quantity<double, second>>(2.0, 0.05);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        benchmark::DoNotOptimize(y);
+        auto r = x * y;
+        benchmark::DoNotOptimize(r);
+    }
+    set_bytes(state, 2, 3);
+
+}
+BENCHMARK(measurement_ctda);
+
+
+// ---------------------------------------------------------------------------------------------
+// arrays
+// ---------------------------------------------------------------------------------------------
+
+template <size_t N>
+static void array_raw(benchmark::State& state) {
+
+    std::array<double, N> a, b;
+    a.fill(1.5);
+    b.fill(2.5);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.data());
+        std::array<double, N> r;
+        for (size_t i = 0; i < N; ++i)
+            r[i] = a[i] * b[i] + a[i];
+        benchmark::DoNotOptimize(r.data());
+    }
+    set_bytes(state, N, 3);
+
+}
+BENCHMARK_TEMPLATE(array_raw, 4);
+BENCHMARK_TEMPLATE(array_raw, 64);
+BENCHMARK_TEMPLATE(array_raw, 1024);
+
+template <size_t N>
+static void array_quantity(benchmark::State& state) {
+
+    quantity<std::array<double, N>, meter> a, b;
+    a.value.fill(1.5);
+    b.value.fill(2.5);
+    auto s = quantity<double, meter>(1.0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.value.data());
+        auto r = a * b + a * s;
+        benchmark::DoNotOptimize(r.value.data());
+    }
+    set_bytes(state, N, 3);
+
+}
+BENCHMARK_TEMPLATE(array_quantity, 4);
+BENCHMARK_TEMPLATE(array_quantity, 64);
+BENCHMARK_TEMPLATE(array_quantity, 1024);
+
+
+// ---------------------------------------------------------------------------------------------
+// vectors
+// ---------------------------------------------------------------------------------------------
+
+static void vector_add_raw(benchmark::State& state) {
+
+    const size_t n = static_cast<size_t>(state.range(0));
+    const column a = make_column(n, 1), b = make_column(n, 2);
+    column r(n);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i)
+            r[i] = a[i] + b[i];
+        benchmark::DoNotOptimize(r.data());
+        benchmark::ClobberMemory();
+    }
+    set_bytes(state, n, 3);
+
+}
+BENCHMARK(vector_add_raw)->CTDA_BENCH_SIZES;
+
+static void vector_add_quantity(benchmark::State& state) {
+
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto a = quantity<column, meter>(make_column(n, 1));
+    const auto b = quantity<column, meter>(make_column(n, 2));
+    quantity<column, meter> r{column(n)};
+    for (auto _ : state) {
+        r = a + b;
+        benchmark::DoNotOptimize(r.value.data());
+        benchmark::ClobberMemory();
+    }
+    set_bytes(state, n, 3);
+
+}
+BENCHMARK(vector_add_quantity)->CTDA_BENCH_SIZES;
+
+
+static void vector_fma_raw(benchmark::State& state) {
+
+    const size_t n = static_cast<size_t>(state.range(0));
+    const column a = make_column(n, 1), b = make_column(n, 2), c = make_column(n, 3);
+    column r(n);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i)
+            r[i] = a[i] * b[i] + c[i];
+        benchmark::DoNotOptimize(r.data());
+        benchmark::ClobberMemory();
+    }
+    set_bytes(state, n, 4);
+
+}
+BENCHMARK(vector_fma_raw)->CTDA_BENCH_SIZES;
+
+static void vector_fma_quantity(benchmark::State& state) {
+
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto a = quantity<column, meter>(make_column(n, 1));
+    const auto b = quantity<column, second>(make_column(n, 2));
+    const auto c = quantity<column, math::multiply_t<meter, second>>(make_column(n, 3));
+    quantity<column, math::multiply_t<meter, second>> r{column(n)};
+    for (auto _ : state) {
+        r = a * b + c;
+        benchmark::DoNotOptimize(r.value.data());
+        benchmark::ClobberMemory();
+    }
+    set_bytes(state, n, 4);
+
+}
+BENCHMARK(vector_fma_quantity)->CTDA_BENCH_SIZES;
+
+
+static void vector_unary_raw(benchmark::State& state) {
+
+    const size_t n = static_cast<size_t>(state.range(0));
+    const column a = make_column(n, 1);
+    column r(n);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i)
+            r[i] = std::sqrt(1.0 / (-a[i] * -a[i]));
+        benchmark::DoNotOptimize(r.data());
+        benchmark::ClobberMemory();
+    }
+    set_bytes(state, n, 2);
+
+}
+BENCHMARK(vector_unary_raw)->CTDA_BENCH_SIZES;
+
+static void vector_unary_quantity(benchmark::State& state) {
+
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto a = quantity<column, meter>(make_column(n, 1));
+    quantity<column, math::invert_t<meter>> r{column(n)};
+    for (auto _ : state) {
+        r = math::sqrt(math::inv(math::sq(-a)));
+        benchmark::DoNotOptimize(r.value.data());
+        benchmark::ClobberMemory();
+    }
+    set_bytes(state, n, 2);
+
+}
+BENCHMARK(vector_unary_quantity)->CTDA_BENCH_SIZES;
+
+
+static void vector_power_raw(benchmark::State& state) {
+
+    const size_t n = static_cast<size_t>(state.range(0));
+    const column a = make_column(n, 1);
+    column r(n);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i)
+            r[i] = 1.0 / (a[i] * a[i] * a[i] * a[i] * a[i]);
+        benchmark::DoNotOptimize(r.data());
+        benchmark::ClobberMemory();
+    }
+    set_bytes(state, n, 2);
+
+}
+BENCHMARK(vector_power_raw)->CTDA_BENCH_SIZES;
+
+static void vector_power_quantity(benchmark::State& state) {
+
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto a = quantity<column, meter>(make_column(n, 1));
+    quantity<column, math::power_t<-5, meter>> r{column(n)};
+    for (auto _ : state) {
+        r = math::pow<-5>(a);
+        benchmark::DoNotOptimize(r.value.data());
+        benchmark::ClobberMemory();
+    }
+    set_bytes(state, n, 2);
+
+}
+BENCHMARK(vector_power_quantity)->CTDA_BENCH_SIZES;
+
+
+static void vector_accumulate_raw(benchmark::State& state) {
+
+    const size_t n = static_cast<size_t>(state.range(0));
+    const column a = make_column(n, 1);
+    column r(n, 0.0);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i)
+            r[i] += a[i];
+        benchmark::DoNotOptimize(r.data());
+        benchmark::ClobberMemory();
+    }
+    set_bytes(state, n, 3);
+
+}
+BENCHMARK(vector_accumulate_raw)->CTDA_BENCH_SIZES;
+
+static void vector_accumulate_quantity(benchmark::State& state) {
+
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto a = quantity<column, meter>(make_column(n, 1));
+    quantity<column, meter> r{column(n, 0.0)};
+    for (auto _ : state) {
+        r += a;
+        benchmark::DoNotOptimize(r.value.data());
+        benchmark::ClobberMemory();
+    }
+    set_bytes(state, n, 3);
+
+}
+BENCHMARK(vector_accumulate_quantity)->CTDA_BENCH_SIZES;
+
+
+static void vector_measurement_raw(benchmark::State& state) {
+
+    const size_t n = static_cast<size_t>(state.range(0));
+    const column xv = make_column(n, 1), xu = make_column(n, 2), yv = make_column(n, 3), yu = make_column(n, 4);
+    for (auto _ : state) {
+        column v(n), u(n);
+        for (size_t i = 0; i < n; ++i) {
+            v[i] = xv[i] * yv[i];
+            u[i] = std::sqrt(xu[i] * yv[i] * xu[i] * yv[i] + xv[i] * yu[i] * xv[i] * yu[i]);
+        }
+        benchmark::DoNotOptimize(v.data());
+        benchmark::DoNotOptimize(u.data());
+    }
+    set_bytes(state, n, 6);
+
+}
+BENCHMARK(vector_measurement_raw)->CTDA_BENCH_SIZES;
+
+static void vector_measurement_ctda(benchmark::State& state) {
+
+    const size_t n = static_cast<size_t>(state.range(0));
+    const measurement_vector<quantity<double, meter>> x(make_column(n, 1), make_column(n, 2));
+    const measurement_vector<quantity<double, second>> y(make_column(n, 3), make_column(n, 4));
+    for (auto _ : state) {
+        auto r = x * y;
+        benchmark::DoNotOptimize(r.val.data());
+        benchmark::DoNotOptimize(r.unc.data());
+    }
+    set_bytes(state, n, 6);
+
+}
+BENCHMARK(vector_measurement_ctda)->CTDA_BENCH_SIZES;
+
+
+// ---------------------------------------------------------------------------------------------
+// statistics
+// ---------------------------------------------------------------------------------------------
+
+static void accumulate_raw(benchmark::State& state) {
+
+    const size_t n = static_cast<size_t>(state.range(0));
+    const column a = make_column(n, 1);
+    for (auto _ : state) {
+        double sum = 0.0, sum_sq = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += a[i];
+            sum_sq += a[i] * a[i];
+        }
+        benchmark::DoNotOptimize(sum);
+        benchmark::DoNotOptimize(sum_sq);
+    }
+    set_bytes(state, n, 1);
+
+}
+BENCHMARK(accumulate_raw)->CTDA_BENCH_SIZES;
+
+static void accumulate_ctda(benchmark::State& state) {
+
+    const size_t n = static_cast<size_t>(state.range(0));
+    const auto a = quantity<column, meter>(make_column(n, 1));
+    for (auto _ : state) {
+        math::accumulator<quantity<double, meter>> acc;
+        acc.push(a);
+        benchmark::DoNotOptimize(acc);
+    }
+    set_bytes(state, n, 1);
+
+}
+BENCHMARK(accumulate_ctda)->CTDA_BENCH_SIZES;
@@ -0,0 +1,134 @@
+# Script of the 'ctda_compile_bench' target: parses compile_time.cpp with the library alone and with its unit expressions,
+# and reports the template specializations and the frontend time of both, reading the '-fmem-report' and '-ftime-report'
+# statistics of GCC. The second column is the cost of the expressions, the one to watch when the unit algebra changes.
+#
+# Variables: CXX (the compiler), CXX_ID (its CMake id), SOURCE, PROJECT_DIR, SIZE (number of expressions), OUTPUT.
+
+
+if(NOT CXX_ID STREQUAL "GNU")
+    message(WARNING "The compile-time benchmark reads the statistics of GCC, and ${CXX_ID} is not supported")
+    return()
+endif()
+
+
+# Convert a time printed with two decimals into hundredths of a second.
+function(to_centiseconds text out)
+    string(REPLACE "." "" digits "${text}")
+    math(EXPR value "${digits} + 0")
+    set(${out} ${value} PARENT_SCOPE)
+endfunction()
+
+# Format hundredths of a second as seconds.
+function(to_seconds value out)
+    set(sign "")
+    if(value LESS 0)
+        set(sign "-")
+        math(EXPR value "0 - ${value}")
+    endif()
+    math(EXPR integer "${value} / 100")
+    math(EXPR fraction "${value} % 100")
+    if(fraction LESS 10)
+        set(fraction "0${fraction}")
+    endif()
+    set(${out} "${sign}${integer}.${fraction}" PARENT_SCOPE)
+endfunction()
+
+
+# Parse the source with the given flags and store its statistics in <prefix>_types, <prefix>_decls,
+# <prefix>_instantiation and <prefix>_frontend.
+function(measure prefix source)
+
+    execute_process(
+        COMMAND ${CXX} -std=c++23 -fsyntax-only -fmem-report -ftime-report
+                -I${PROJECT_DIR}/include -I${PROJECT_DIR}/src -DCTDA_COMPILE_BENCH_SIZE=${SIZE} ${ARGN} ${source}
+        RESULT_VARIABLE result
+        ERROR_VARIABLE report
+        OUTPUT_QUIET
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Cannot compile ${source}:\n${report}")
+    endif()
+
+    string(REGEX MATCH "type_specializations: size [0-9]+, ([0-9]+) elements" _ "${report}")
+    set(${prefix}_types ${CMAKE_MATCH_1} PARENT_SCOPE)
+    string(REGEX MATCH "decl_specializations: size [0-9]+, ([0-9]+) elements" _ "${report}")
+    set(${prefix}_decls ${CMAKE_MATCH_1} PARENT_SCOPE)
+
+    # user times, steadier than the wall ones
+    string(REGEX MATCH "template instantiation *: *([0-9]+\\.[0-9][0-9])" _ "${report}")
+    to_centiseconds(${CMAKE_MATCH_1} instantiation)
+    set(${prefix}_instantiation ${instantiation} PARENT_SCOPE)
+    string(REGEX MATCH "TOTAL *: *([0-9]+\\.[0-9][0-9])" _ "${report}")
+    to_centiseconds(${CMAKE_MATCH_1} frontend)
+    set(${prefix}_frontend ${frontend} PARENT_SCOPE)
+
+endfunction()
+
+
+measure(library ${SOURCE} -DCTDA_COMPILE_BENCH_BASELINE)
+measure(total ${SOURCE})
+
+# the cost of including each header of the library in an empty translation unit
+set(headers ctda.hpp ctda_io.hpp ctda_parallel.hpp ctda_propagation.hpp ctda_monte_carlo.hpp ctda_linear_algebra.hpp)
+foreach(header ${headers})
+    measure(${header} /dev/null -x c++ -include ${header})
+endforeach()
+
+
+set(table "ctda compile-time benchmark, ${SIZE} unit expressions\n")
+string(APPEND table "                                library  expressions        total\n")
+
+foreach(row types decls instantiation frontend)
+
+    math(EXPR expressions "${total_${row}} - ${library_${row}}")
+    set(cells ${library_${row}} ${expressions} ${total_${row}})
+
+    if(row STREQUAL "types")
+        set(line "type specializations      ")
+    elseif(row STREQUAL "decls")
+        set(line "decl specializations      ")
+    elseif(row STREQUAL "instantiation")
+        set(line "template instantiation [s]")
+    else()
+        set(line "frontend [s]              ")
+    endif()
+
+    foreach(cell ${cells})
+        if(row STREQUAL "instantiation" OR row STREQUAL "frontend")
+            to_seconds(${cell} cell)
+        endif()
+        string(LENGTH "${cell}" length)
+        math(EXPR padding "13 - ${length}")
+        string(REPEAT " " ${padding} spaces)
+        string(APPEND line "${spaces}${cell}")
+    endforeach()
+
+    string(APPEND table "${line}\n")
+
+endforeach()
+
+
+string(APPEND table "\ninclude cost, empty translation unit    decl specializations frontend [s]\n")
+
+foreach(header ${headers})
+
+    to_seconds(${${header}_frontend} frontend)
+    string(LENGTH "${header}" length)
+    math(EXPR padding "40 - ${length}")
+    string(REPEAT " " ${padding} line)
+    set(line "${header}${line}")
+
+    foreach(cell ${${header}_decls} ${frontend})
+        string(LENGTH "${cell}" length)
+        math(EXPR padding "13 - ${length}")
+        string(REPEAT " " ${padding} spaces)
+        string(APPEND line "${spaces}${cell}")
+    endforeach()
+
+    string(APPEND table "${line}\n")
+
+endforeach()
+
+
+message("${table}")
+file(WRITE ${OUTPUT} "${table}")
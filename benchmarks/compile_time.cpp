@@ -0,0 +1,60 @@
+/**
+ * @file    benchmarks/compile_time.cpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the unit expressions whose compilation is measured by the 'ctda_compile_bench' target.
+ * @note    It is only parsed, never linked: compiled with CTDA_COMPILE_BENCH_BASELINE defined it includes the library alone,
+ *          so the difference of the two runs is the cost of the unit algebra of the expressions.
+ * @date    2023-12-01
+ * @copyright Copyright (c) 2023
+ */
+
+
+#include "ctda.hpp"
+
+using namespace ctda;
+
+
+#ifndef CTDA_COMPILE_BENCH_BASELINE
+
+/// number of distinct derived bases generated
+#ifndef CTDA_COMPILE_BENCH_SIZE
+    #define CTDA_COMPILE_BENCH_SIZE 96
+#endif
+
+
+/// @brief A derived base, distinct for every I in [0, 120): L^(1..4) M^(0..2) T^-(1..5) K^(0,1) A^(0,-1).
+template <size_t I>
+using derived_t = math::multiply_t<math::multiply_t<math::power_t<I % 4 + 1, basis::length>, math::power_t<I / 4 % 3, basis::mass>>,
+                                   math::divide_t<math::power_t<I / 12 % 2, basis::temperature>,
+                                                  math::multiply_t<math::power_t<I % 5 + 1, basis::time>, math::power_t<I / 24 % 2, basis::elettric_current>>>>;
+
+
+/// @brief The chain of a typical physics expression: quotients, products, squares and a square root of quantities,
+///        with a prefixed unit converted along the way.
+template <size_t I>
+double chain() {
+
+    using unit_t = unit<derived_t<I>, std::ratio<1, 1000>>;
+
+    const quantity<double, unit_t> x(1.5);
+    const quantity<double, units::second> t(2.0);
+    const quantity<double, units::kilogram> m(3.0);
+
+    const auto v = x / t;
+    const auto p = m * v;
+    const auto e = math::sq(p) / m;
+    const auto r = math::sqrt(e * m) / m * t;
+    return math::convert<unit<derived_t<I>>>(r).value + math::inv(v * t).value;
+
+}
+
+
+double run() {
+
+    return []<size_t... I>(std::index_sequence<I...>) {
+        return (chain<I>() + ...);
+    }(std::make_index_sequence<CTDA_COMPILE_BENCH_SIZE>{});
+
+}
+
+#endif
@@ -1,7 +1,10 @@
 /**
  * @file    ctda/ctda.hpp
  * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
- * @brief   This file contains the import of all the headers of the library. 
+ * @brief   This file contains the import of the headers of the unit algebra: quantities, measurements and their operations.
+ * @note    The I/O, the thread pool, the propagation of correlated uncertainties, the Monte Carlo propagation and the linear algebra
+ *          pull heavier standard headers, and are imported separately by 'ctda_io.hpp', 'ctda_parallel.hpp', 'ctda_propagation.hpp',
+ *          'ctda_monte_carlo.hpp' and 'ctda_linear_algebra.hpp'.
  * @date    2023-09-11
  * 
  * @copyright Copyright (c) 2023
@@ -10,36 +13,67 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <compare>
 #include <complex>
+#include <cstdint>
+#include <cstring>
 #include <cmath>    
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <numbers>
+#include <ranges>
 #include <ratio>
+#include <span>
 #include <string_view>
+#include <stdexcept>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 
 #define CTDA_QUANTITY_ACCESS_W_CURVY_BRACKETS 1
 
+#ifndef CTDA_USE_SIMD
+    #define CTDA_USE_SIMD 1
+#endif
 
+
+#include "precision.hpp"
 #include "traits.hpp"
+#include "memory.hpp"
+#include "math/simd.hpp"
 
 #include "core/base_quantity.hpp"
 #include "core/unit.hpp"
 #include "core/quantity.hpp"
 #include "core/measurement.hpp"
+#include "core/dual.hpp"
+#include "core/complex_vector.hpp"
+#include "core/expression.hpp"
+#include "core/layout.hpp"
+#include "core/view.hpp"
+#include "core/dynamic_quantity.hpp"
 
 #include "math/operations.hpp"
 #include "math/operators.hpp"
 #include "math/algebraic/add.hpp"
+#include "math/algebraic/subtract.hpp"
 #include "math/algebraic/multiply.hpp"
 #include "math/algebraic/negate.hpp"
 #include "math/algebraic/invert.hpp"
+#include "math/algebraic/divide.hpp"
 #include "math/algebraic/power.hpp"
 #include "math/algebraic/root.hpp"
+#include "math/algebraic/scale.hpp"
+#include "math/statistics.hpp"
+#include "math/differentiation.hpp"
+#include "math/complex.hpp"
 
 #include "basis.hpp"
 #include "units.hpp" 
-
-#include "io.hpp"
-
@@ -0,0 +1,33 @@
+/**
+ * @file    ctda/ctda_io.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the import of the headers writing and reading quantities as text and as binary files.
+ * @date    2023-11-20
+ * 
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+#include "ctda.hpp"
+
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+
+#if __has_include(<format>)
+    #include <format>
+#endif
+
+#if __has_include(<sys/mman.h>)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "format.hpp"
+#include "parse.hpp"
+#include "binary.hpp"
+#include "io.hpp"
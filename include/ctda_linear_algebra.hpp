@@ -0,0 +1,15 @@
+/**
+ * @file    ctda/ctda_linear_algebra.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the import of the linear algebra of quantities.
+ * @date    2023-11-29
+ * 
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+#include "ctda.hpp"
+
+#include "math/linear_algebra.hpp"
@@ -0,0 +1,15 @@
+/**
+ * @file    ctda/ctda_monte_carlo.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the import of the Monte Carlo propagation of uncertainties.
+ * @date    2023-11-26
+ * 
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+#include "ctda_parallel.hpp"
+
+#include "math/monte_carlo.hpp"
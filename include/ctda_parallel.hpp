@@ -0,0 +1,21 @@
+/**
+ * @file    ctda/ctda_parallel.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the import of the thread pool and of the operations taking an execution policy.
+ * @date    2023-11-15
+ * 
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+#include "ctda.hpp"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "thread_pool.hpp"
+#include "math/parallel.hpp"
@@ -0,0 +1,19 @@
+/**
+ * @file    ctda/ctda_propagation.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the import of the linear propagation of correlated uncertainties.
+ * @date    2023-11-25
+ * 
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+#include "ctda.hpp"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include "math/propagation.hpp"
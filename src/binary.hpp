@@ -0,0 +1,299 @@
+/**
+ * @file    binary.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the binary columnar format of quantities and measurements and its memory-mapped reader.
+ * @date    2023-11-22
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    /// @brief Header of a binary column: the base, the prefix and the value type of the quantity stored.
+    /// @note  The header takes 64 bytes, then the values follow as a raw array, and for a measurement
+    ///        the uncertainties follow as a second raw array. Each array starts on a 64 bytes boundary.
+    struct binary_header {
+
+        std::array<char, 4> magic = {'C', 'T', 'D', 'A'};
+
+        uint16_t version = 1;
+
+        uint16_t endian = 0x0102;               //< written in the byte order of the machine
+
+        std::array<int32_t, 7> powers{};        //< powers of the base, numerators over 'power_den' + 1
+
+        uint8_t value_kind = 0;                 //< 0 signed, 1 unsigned, 2 floating point, 3 complex, 4 bfloat16
+
+        uint8_t value_size = 0;                 //< size of a value in bytes
+
+        uint8_t columns = 1;                    //< 1 for a quantity, 2 for a measurement
+
+        uint8_t power_den = 0;                  //< common denominator of the powers minus one, as in a 'dimension'
+
+        int64_t num = 1, den = 1;               //< prefix of the unit
+
+        uint64_t count = 0;                     //< number of values
+
+
+        static constexpr size_t alignment = 64;
+
+
+        /// @brief Get the header of 'columns' columns of 'count' values of type ELEMENT_T in UNIT_T.
+        template <typename ELEMENT_T, typename UNIT_T>
+            requires ((is_scalar_v<ELEMENT_T> || is_reduced_precision_v<ELEMENT_T>) && is_unit_v<UNIT_T>)
+        static constexpr binary_header of(size_t count, uint8_t columns = 1) noexcept {
+
+            binary_header header;
+            for (size_t i = 0; i < 7; ++i)
+                header.powers[i] = UNIT_T::base_t::powers[i];
+            header.power_den = static_cast<uint8_t>(UNIT_T::base_t::den - 1);
+            header.value_kind = std::is_same_v<ELEMENT_T, bfloat16_t> ? 4 : is_complex_v<ELEMENT_T> ? 3 : 
+                                std::is_floating_point_v<compute_t<ELEMENT_T>> ? 2 : std::is_unsigned_v<ELEMENT_T> ? 1 : 0;
+            header.value_size = sizeof(ELEMENT_T);
+            header.columns = columns;
+            header.num = UNIT_T::prefix_t::num;
+            header.den = UNIT_T::prefix_t::den;
+            header.count = count;
+            return header;
+
+        }
+
+        /// @brief Get the offset of a column from the start of the file.
+        constexpr size_t offset(size_t column) const noexcept {
+
+            const size_t bytes = (this->count * this->value_size + alignment - 1) / alignment * alignment;
+            return alignment + column * bytes;
+
+        }
+
+        /// @brief Check if two headers describe the same columns, the number of values apart.
+        constexpr bool same_layout(const binary_header& other) const noexcept {
+
+            return this->magic == other.magic && this->version == other.version && this->endian == other.endian &&
+                   this->powers == other.powers && this->power_den == other.power_den && this->value_kind == other.value_kind && this->value_size == other.value_size &&
+                   this->columns == other.columns && this->num == other.num && this->den == other.den;
+
+        }
+
+    }; // struct binary_header
+
+    static_assert(sizeof(binary_header) == binary_header::alignment && std::is_trivially_copyable_v<binary_header>);
+
+
+    /// @brief Write the columns of a binary file.
+    template <typename T>
+    void save_columns(const std::filesystem::path& path, const binary_header& header, std::initializer_list<const T*> columns) {
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            throw std::runtime_error("Cannot open " + path.string() + " for writing");
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        const std::array<char, binary_header::alignment> padding{};
+        const size_t bytes = header.count * sizeof(T);
+        for (const T* data : columns) {
+            file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+            file.write(padding.data(), static_cast<std::streamsize>((binary_header::alignment - bytes % binary_header::alignment) % binary_header::alignment));
+        }
+
+        if (!file)
+            throw std::runtime_error("Cannot write " + path.string());
+
+    }
+
+
+    /// @brief Save a quantity storing a contiguous range of values to a binary file.
+    template <typename T>
+        requires (is_quantity_v<T> && std::ranges::contiguous_range<typename T::value_t> &&
+                  (is_scalar_v<std::ranges::range_value_t<typename T::value_t>> || is_reduced_precision_v<std::ranges::range_value_t<typename T::value_t>>))
+    void save(const std::filesystem::path& path, const T& q) {
+
+        const size_t count = std::ranges::size(q.value);
+        using element_t = std::remove_cvref_t<std::ranges::range_value_t<typename T::value_t>>;
+        save_columns(path, binary_header::of<element_t, typename T::unit_t>(count), {std::ranges::data(q.value)});
+
+    }
+
+    /// @brief Save a measurement storing contiguous ranges of values and of uncertainties to a binary file.
+    template <typename T>
+        requires (is_measurement_v<T> && std::ranges::contiguous_range<typename T::value_t> &&
+                  (is_scalar_v<std::ranges::range_value_t<typename T::value_t>> || is_reduced_precision_v<std::ranges::range_value_t<typename T::value_t>>))
+    void save(const std::filesystem::path& path, const T& m) {
+
+        const size_t count = std::ranges::size(m.val);
+        if (std::ranges::size(m.unc) != count)
+            throw std::runtime_error("Cannot save a measurement with a different number of values and uncertainties");
+
+        using element_t = std::remove_cvref_t<std::ranges::range_value_t<typename T::value_t>>;
+        save_columns(path, binary_header::of<element_t, typename T::unit_t>(count, 2), {std::ranges::data(m.val), std::ranges::data(m.unc)});
+
+    }
+
+
+#if __has_include(<sys/mman.h>)
+
+
+    /// @brief This template meta-struct maps a binary file of quantities or of measurements into memory.
+    /// @note  The header is checked against T when the file is opened. The values are never copied:
+    ///        the views point into the pages of the file, so they must not outlive the 'mapped_column'.
+    /// @tparam The quantity or the measurement of a single value stored in the file, like 'quantity<double, units::metre>'.
+    template <typename T>
+        requires ((is_quantity_v<T> || is_measurement_v<T>) && (is_scalar_v<typename T::value_t> || is_reduced_precision_v<typename T::value_t>))
+    struct mapped_column {
+
+
+        using value_t = typename T::value_t;
+
+        using unit_t = typename T::unit_t;
+
+        using quantity_t = quantity<value_t, unit_t>;
+
+        using view_t = quantity<std::span<const value_t>, unit_t>;
+
+
+        /// @brief Constructor from the path of the file.
+        explicit mapped_column(const std::filesystem::path& path) {
+
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw std::runtime_error("Cannot open " + path.string());
+
+            struct stat status{};
+            if (::fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(binary_header)) {
+                ::close(fd);
+                throw std::runtime_error("Cannot read the header of " + path.string());
+            }
+
+            this->bytes = static_cast<size_t>(status.st_size);
+            this->data = ::mmap(nullptr, this->bytes, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+
+            if (this->data == MAP_FAILED) {
+                this->data = nullptr;
+                throw std::runtime_error("Cannot map " + path.string());
+            }
+
+            std::memcpy(&this->header, this->data, sizeof(binary_header));
+            const binary_header expected = binary_header::of<value_t, unit_t>(0, is_measurement_v<T> ? 2 : 1);
+            if (this->header.magic == expected.magic && this->header.endian == __builtin_bswap16(expected.endian)) {
+                this->unmap();
+                throw std::runtime_error("The file " + path.string() + " was written on a machine with another byte order");
+            }
+            if (!this->header.same_layout(expected)) {
+                this->unmap();
+                throw std::runtime_error("The unit or the value type of " + path.string() + " does not match the one requested");
+            }
+
+            // the count is checked before computing the offsets, which a crafted count could wrap around
+            if (this->header.count > (this->bytes - binary_header::alignment) / this->header.value_size ||
+                this->bytes < this->header.offset(this->header.columns)) {
+                this->unmap();
+                throw std::runtime_error("The file " + path.string() + " is truncated");
+            }
+
+        }
+
+        mapped_column(const mapped_column&) = delete;
+
+        mapped_column& operator=(const mapped_column&) = delete;
+
+        mapped_column(mapped_column&& other) noexcept :
+            data{std::exchange(other.data, nullptr)}, bytes{std::exchange(other.bytes, 0)}, header{other.header} {}
+
+        mapped_column& operator=(mapped_column&& other) noexcept {
+
+            if (this != &other) {
+                this->unmap();
+                this->data = std::exchange(other.data, nullptr);
+                this->bytes = std::exchange(other.bytes, 0);
+                this->header = other.header;
+            }
+            return *this;
+
+        }
+
+        /// @brief Destructor, unmaps the file.
+        ~mapped_column() noexcept {
+
+            this->unmap();
+
+        }
+
+
+        /// @brief Get the number of values stored.
+        size_t size() const noexcept {
+
+            return this->header.count;
+
+        }
+
+        /// @brief Get a view of the values, as a quantity storing a span.
+        view_t value() const noexcept {
+
+            return std::span<const value_t>(this->column(0), this->size());
+
+        }
+
+        /// @brief Get a view of the uncertainties, as a quantity storing a span.
+        view_t uncertainty() const noexcept
+            requires (is_measurement_v<T>) {
+
+            return std::span<const value_t>(this->column(1), this->size());
+
+        }
+
+        /// @brief Get a view of the values as quantities.
+        std::span<const quantity_t> quantities() const noexcept {
+
+            return as_quantities<unit_t>(std::span<const value_t>(this->column(0), this->size()));
+
+        }
+
+        /// @brief Access an element of the column.
+        T operator[](size_t i) const noexcept {
+
+            if constexpr (is_measurement_v<T>)
+                return T(this->column(0)[i], this->column(1)[i]);
+            else
+                return T(this->column(0)[i]);
+
+        }
+
+
+      private:
+
+
+        void* data = nullptr;
+
+        size_t bytes = 0;
+
+        binary_header header;
+
+
+        const value_t* column(size_t i) const noexcept {
+
+            return reinterpret_cast<const value_t*>(static_cast<const char*>(this->data) + this->header.offset(i));
+
+        }
+
+        void unmap() noexcept {
+
+            if (this->data != nullptr)
+                ::munmap(this->data, this->bytes);
+            this->data = nullptr;
+
+        }
+
+
+    }; // struct mapped_column
+
+
+#endif
+
+
+} // namespace ctda
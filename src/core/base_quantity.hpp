@@ -13,14 +13,174 @@
 namespace ctda {
     
 
+    /// @brief This struct contains the seven powers of a base packed in a 64 bits word: the numerators in the low seven bytes,
+    ///        one signed byte each, and their common denominator minus one in the high byte, so integer powers have it zero.
+    /// @note  The powers are kept reduced, so two dimensions are compared with a single integer comparison.
+    ///        The powers of a product of dimensions with the same denominator are added in all the bytes at once,
+    ///        with carries kept inside each byte. A numerator out of [-128, 127] or a denominator over 256 throws,
+    ///        which is a compile error when the dimension is the argument of a base.
+    struct dimension {
+
+
+        uint64_t bits = 0;
+
+
+        /// @brief Pack the powers num[i] / den of a base, reducing them.
+        static constexpr dimension pack(const std::array<int, 7>& num, int den = 1) {
+
+            if (den == 0)
+                throw std::invalid_argument("Cannot pack powers with a null denominator");
+
+            int g = den;
+            for (int x : num)
+                g = std::gcd(g, x);
+            if (den < 0)
+                g = -g;
+
+            if (den / g > 256)
+                throw std::overflow_error("Cannot pack a denominator out of the range of a byte");
+            dimension d{static_cast<uint64_t>(den / g - 1) << 56};
+            for (size_t i = 0; i < 7; ++i) {
+                const int x = num[i] / g;
+                if (x < std::numeric_limits<int8_t>::min() || x > std::numeric_limits<int8_t>::max())
+                    throw std::overflow_error("Cannot pack a power out of the range of a byte");
+                d.bits |= static_cast<uint64_t>(static_cast<uint8_t>(x)) << (8 * i);
+            }
+            return d;
+
+        }
+
+        template <typename BASE_T>
+            requires (is_base_v<BASE_T>)
+        static constexpr dimension of() noexcept {
+
+            return {BASE_T::packed};
+
+        }
+
+
+        /// @brief Get the numerator of the power i.
+        constexpr int power(size_t i) const noexcept {
+
+            return static_cast<int8_t>(static_cast<uint8_t>(this->bits >> (8 * i)));
+
+        }
+
+        /// @brief Unpack the numerators of the powers.
+        constexpr std::array<int, 7> powers() const noexcept {
+
+            std::array<int, 7> p{};
+            for (size_t i = 0; i < 7; ++i)
+                p[i] = this->power(i);
+            return p;
+
+        }
+
+        /// @brief Get the common denominator of the powers, 1 if they are all integers.
+        constexpr int den() const noexcept {
+
+            return static_cast<int>(this->bits >> 56) + 1;
+
+        }
+
+
+        /// @brief Get the dimension of the product: the powers are added byte by byte.
+        friend constexpr dimension operator*(const dimension& x, const dimension& y) {
+
+            if ((x.bits ^ y.bits) >> 56)
+                return combine(x, y, 1);
+
+            const uint64_t a = x.bits, b = y.bits;
+            const uint64_t r = (((a & ~high) + (b & ~high)) ^ ((a ^ b) & high)) & mask;
+            if ((a ^ r) & (b ^ r) & high)
+                throw std::overflow_error("Cannot multiply dimensions, a power overflows");
+            return a >> 56 ? pack(dimension{r}.powers(), x.den()) : dimension{r};
+
+        }
+
+        /// @brief Get the dimension of the quotient: the powers are subtracted byte by byte.
+        friend constexpr dimension operator/(const dimension& x, const dimension& y) {
+
+            if ((x.bits ^ y.bits) >> 56)
+                return combine(x, y, -1);
+
+            const uint64_t a = x.bits, b = y.bits;
+            const uint64_t r = (((a | high) - (b & ~high)) ^ ((a ^ ~b) & high)) & mask;
+            if ((a ^ b) & (a ^ r) & high)
+                throw std::overflow_error("Cannot divide dimensions, a power overflows");
+            return a >> 56 ? pack(dimension{r}.powers(), x.den()) : dimension{r};
+
+        }
+
+        /// @brief Get the dimension raised to an integer power.
+        constexpr dimension pow(int p) const {
+
+            std::array<int, 7> powers = this->powers();
+            for (int& x : powers)
+                x *= p;
+            return pack(powers, this->den());
+
+        }
+
+        /// @brief Get the dimension of the root of index p: each power is divided by p, exactly.
+        constexpr dimension root(int p) const {
+
+            return pack(this->powers(), this->den() * p);
+
+        }
+
+        friend constexpr bool operator==(const dimension& x, const dimension& y) noexcept {
+
+            return x.bits == y.bits;
+
+        }
+
+
+      private:
+
+
+        static constexpr uint64_t high = 0x0080808080808080;       //< sign bits of the seven bytes
+
+        static constexpr uint64_t mask = 0x00FFFFFFFFFFFFFF;       //< bytes of the powers
+
+
+        /// @brief Get the dimension x * y^sign of two dimensions with different denominators, over their least common multiple.
+        static constexpr dimension combine(const dimension& x, const dimension& y, int sign) {
+
+            const int den = std::lcm(x.den(), y.den());
+            std::array<int, 7> powers{};
+            for (size_t i = 0; i < 7; ++i)
+                powers[i] = x.power(i) * (den / x.den()) + sign * y.power(i) * (den / y.den());
+            return pack(powers, den);
+
+        }
+
+
+    }; // struct dimension
+
+
     /// @brief This template meta-structure contains the dimensional information for a physical quantity.
-    template <int LENGTH, int TIME, int MASS, int TEMPERATURE, int ELETTRIC_CURRENT, int SUBSTANCE_AMOUNT, int LUMINOUS_INTENSITY> 
-    struct base_quantity {
+    /// @note  The seven powers are packed in a single template argument, the bits of their 'dimension',
+    ///        so the algebra of the bases computes one word and instantiates a single type for its result.
+    ///        The powers are rational, as the ones of the roots of a base, like the m^1/2 of a spectral density.
+    template <uint64_t POWERS> 
+    struct packed_base {
+
+        /// packed powers of the base_quantity
+        static constexpr uint64_t packed = POWERS;
+
+        /// powers of the base_quantity, numerators over 'den'
+        static constexpr std::array<int, 7> powers = dimension{POWERS}.powers();
 
-        /// powers of the base_quantity
-        static constexpr std::array<int, 7> powers = {LENGTH, TIME, MASS, TEMPERATURE, ELETTRIC_CURRENT, SUBSTANCE_AMOUNT, LUMINOUS_INTENSITY};
+        /// common denominator of the powers, 1 if they are all integers
+        static constexpr int den = dimension{POWERS}.den();
         
-    }; // struct base_quantity
+    }; // struct packed_base
+
+
+    /// @brief The base_quantity of the given powers of the SI base quantities.
+    template <int LENGTH, int TIME, int MASS, int TEMPERATURE, int ELETTRIC_CURRENT, int SUBSTANCE_AMOUNT, int LUMINOUS_INTENSITY> 
+    using base_quantity = packed_base<dimension::pack({LENGTH, TIME, MASS, TEMPERATURE, ELETTRIC_CURRENT, SUBSTANCE_AMOUNT, LUMINOUS_INTENSITY}).bits>;
 
 
     /// @brief Literals of the SI base quantities
@@ -30,4 +190,4 @@ namespace ctda {
     using dimensionless = base_quantity<0, 0, 0, 0, 0, 0, 0>;
 
 
-} // namespace ctda
\ No newline at end of file
+} // namespace ctda
@@ -0,0 +1,152 @@
+/**
+ * @file    ctda/core/complex_vector.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the implementation of the 'complex_vector' struct, a column of complex numbers stored in split planes.
+ * @date    2023-11-28
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    /// @brief This namespace contains the containers with a split layout,
+    ///        kept apart so that the operators of 'ctda' are not found for their planes by argument dependent lookup.
+    namespace split {
+
+
+        /// @brief This template meta-struct contains a column of complex numbers, with the real and the imaginary parts in two planes.
+        /// @note  The kernels load a full register of real parts and one of imaginary parts with no shuffle,
+        ///        where a 'std::vector<std::complex<T>>' has to split them at every operation.
+        ///        An interleaved buffer is converted in a single pass, reading and writing it in place
+        ///        through the layout of 'std::complex<T>', which is the one of T[2].
+        /// @tparam T: the type of the parts, float or double
+        /// @tparam ALLOC_T: the allocator of the planes
+        template <typename T, typename ALLOC_T>
+            requires (std::is_floating_point_v<T>)
+        struct complex_vector {
+
+
+            using value_type = std::complex<T>;
+
+            using allocator_type = ALLOC_T;
+
+            using plane_t = std::vector<T, ALLOC_T>;
+
+
+            plane_t re;         //< real parts
+
+            plane_t im;         //< imaginary parts
+
+
+            constexpr complex_vector() = default;
+
+            /// @brief Constructor of n zeros.
+            explicit constexpr complex_vector(size_t n, const ALLOC_T& alloc = ALLOC_T()) : re(n, alloc), im(n, alloc) {}
+
+            /// @brief Constructor from the planes, which are moved in without copying.
+            constexpr complex_vector(plane_t re, plane_t im) : re{std::move(re)}, im{std::move(im)} {
+
+                if (this->re.size() != this->im.size())
+                    throw std::runtime_error("Cannot build a complex vector from planes of different sizes");
+
+            }
+
+            /// @brief Constructor from interleaved complex numbers, split with the SIMD kernels.
+            explicit complex_vector(std::span<const std::complex<T>> z, const ALLOC_T& alloc = ALLOC_T()) : complex_vector(z.size(), alloc) {
+
+                math::simd::deinterleave(reinterpret_cast<const T*>(z.data()), this->re.data(), this->im.data(), z.size());
+
+            }
+
+            complex_vector(std::initializer_list<std::complex<T>> z) : complex_vector(std::span<const std::complex<T>>(z.begin(), z.size())) {}
+
+
+            /// @brief Get the number of complex numbers.
+            constexpr size_t size() const noexcept {
+
+                return this->re.size();
+
+            }
+
+            constexpr bool empty() const noexcept {
+
+                return this->re.empty();
+
+            }
+
+            constexpr void resize(size_t n) {
+
+                this->re.resize(n);
+                this->im.resize(n);
+
+            }
+
+            constexpr allocator_type get_allocator() const noexcept {
+
+                return this->re.get_allocator();
+
+            }
+
+
+            /// @brief Get the complex number i, gathered from the planes.
+            constexpr std::complex<T> operator[](size_t i) const noexcept {
+
+                return {this->re[i], this->im[i]};
+
+            }
+
+            /// @brief Set the complex number i, scattered to the planes.
+            constexpr void set(size_t i, const std::complex<T>& z) noexcept {
+
+                this->re[i] = z.real();
+                this->im[i] = z.imag();
+
+            }
+
+
+            /// @brief View the real parts.
+            constexpr std::span<const T> real() const noexcept {
+
+                return this->re;
+
+            }
+
+            /// @brief View the imaginary parts.
+            constexpr std::span<const T> imag() const noexcept {
+
+                return this->im;
+
+            }
+
+
+            /// @brief Write the complex numbers interleaved into z, merged with the SIMD kernels.
+            void interleave(std::span<std::complex<T>> z) const {
+
+                if (z.size() != this->size())
+                    throw std::runtime_error("Cannot interleave a complex vector into a buffer of a different size");
+
+                math::simd::interleave(this->re.data(), this->im.data(), reinterpret_cast<T*>(z.data()), z.size());
+
+            }
+
+            /// @brief Get the complex numbers interleaved, in a vector allocated like the planes.
+            std::vector<std::complex<T>, memory::rebind_alloc_t<ALLOC_T, std::complex<T>>> interleaved() const {
+
+                std::vector<std::complex<T>, memory::rebind_alloc_t<ALLOC_T, std::complex<T>>> z(this->size(), memory::rebind_allocator<std::complex<T>>(this->get_allocator()));
+                this->interleave(z);
+                return z;
+
+            }
+
+
+        }; // struct complex_vector
+
+
+    } // namespace split
+
+
+} // namespace ctda
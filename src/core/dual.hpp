@@ -0,0 +1,80 @@
+/**
+ * @file    ctda/core/dual.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the implementation of the 'dual' struct, used by the forward mode differentiation.
+ * @date    2023-11-27
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    /// @brief This namespace contains the types of the automatic differentiation,
+    ///        kept apart so that the operators of 'ctda' are not found for their containers by argument dependent lookup.
+    namespace ad {
+
+
+        /// @brief This template meta-struct contains a dual number: a value and its derivatives with respect to N variables.
+        /// @note  The tangents are packed in SIMD registers, padded with zeros to a power of two lanes,
+        ///        so that each operation updates all of them at once. As the value of a quantity,
+        ///        the tangents are stored in the unit of the quantity: 'math::derivative' divides them by the unit of the variable.
+        /// @tparam T: the type of the value, float or double
+        /// @tparam N: the number of variables
+        template <typename T, size_t N>
+            requires ((std::is_same_v<T, float> || std::is_same_v<T, double>) && N > 0)
+        struct dual {
+
+
+            using value_type = T;
+
+            using tangent_t = typename math::simd::pack<T, std::bit_ceil(N) * sizeof(T)>::type;
+
+
+            T val;              //< value
+
+            tangent_t d;        //< derivatives with respect to the variables
+
+
+            constexpr dual() noexcept : val{}, d{} {}
+
+            constexpr dual(const T& val) noexcept : val{val}, d{} {}
+
+            constexpr dual(const T& val, const tangent_t& d) noexcept : val{val}, d{d} {}
+
+
+            /// @brief Get the dual number of the variable i, whose derivative with respect to itself is one.
+            static constexpr dual variable(const T& val, size_t i) noexcept {
+
+                dual x(val);
+                x.d[i] = T(1);
+                return x;
+
+            }
+
+
+            /// @brief Get the number of variables.
+            static constexpr size_t size() noexcept {
+
+                return N;
+
+            }
+
+            /// @brief Get the derivative with respect to the variable i.
+            constexpr T tangent(size_t i) const noexcept {
+
+                return this->d[i];
+
+            }
+
+
+        }; // struct dual
+
+
+    } // namespace ad
+
+
+} // namespace ctda
@@ -0,0 +1,243 @@
+/**
+ * @file    ctda/core/dynamic_quantity.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the implementation of the 'dynamic_unit' and 'dynamic_quantity' structs, whose units are known at runtime.
+ * @date    2023-11-30
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    /// @brief This namespace contains the types whose units are known at runtime,
+    ///        kept apart so that the operators of 'ctda' are not found for their containers by argument dependent lookup.
+    namespace runtime {
+
+
+        /// @brief This struct contains a unit known at runtime: a packed 'dimension', as the one of the bases, and an exact 'rational' prefix.
+        struct dynamic_unit {
+
+
+            ctda::dimension dimension;
+
+            ctda::rational prefix;
+
+
+            /// @brief Get the dynamic unit of a static unit.
+            template <typename UNIT_T>
+                requires (is_unit_v<UNIT_T>)
+            static constexpr dynamic_unit of() noexcept {
+
+                return {ctda::dimension::of<typename UNIT_T::base_t>(), rational::of<typename UNIT_T::prefix_t>()};
+
+            }
+
+
+            /// @brief Check if the unit has the base of the static unit UNIT_T, with a single integer comparison.
+            template <typename UNIT_T>
+                requires (is_unit_v<UNIT_T>)
+            constexpr bool has_base() const noexcept {
+
+                return this->dimension == ctda::dimension::of<typename UNIT_T::base_t>();
+
+            }
+
+
+            friend constexpr dynamic_unit operator*(const dynamic_unit& x, const dynamic_unit& y) {
+
+                return {x.dimension * y.dimension, x.prefix * y.prefix};
+
+            }
+
+            friend constexpr dynamic_unit operator/(const dynamic_unit& x, const dynamic_unit& y) {
+
+                return {x.dimension / y.dimension, x.prefix / y.prefix};
+
+            }
+
+            constexpr dynamic_unit pow(int p) const {
+
+                return {this->dimension.pow(p), this->prefix.pow(p)};
+
+            }
+
+            constexpr dynamic_unit root(int p) const {
+
+                return {this->dimension.root(p), this->prefix.root(p)};
+
+            }
+
+            friend constexpr bool operator==(const dynamic_unit& x, const dynamic_unit& y) noexcept {
+
+                return x.dimension == y.dimension && x.prefix == y.prefix;
+
+            }
+
+
+        }; // struct dynamic_unit
+
+
+        /// @brief This struct contains the exact ratio converting the values from a prefix to another, cached by thread.
+        /// @note  Reducing the ratio takes a few divisions, while the same pairs of units recur in a stream of values:
+        ///        the ratios are kept in a small direct-mapped table of the calling thread, overwritten on collision.
+        struct conversion_cache {
+
+
+            /// @brief Get the ratio converting a value from the prefix 'from' to the prefix 'to'.
+            static rational get(const rational& from, const rational& to) {
+
+                if (from == to)
+                    return {};
+
+                entry& e = table()[hash(from, to) % size];
+                if (!(e.from == from && e.to == to))
+                    e = {from, to, from / to};
+                return e.ratio;
+
+            }
+
+
+          private:
+
+
+            struct entry {
+
+                rational from{0, 0};
+
+                rational to{0, 0};
+
+                rational ratio;
+
+            };
+
+            static constexpr size_t size = 64;
+
+            static size_t hash(const rational& from, const rational& to) noexcept {
+
+                uint64_t h = 0xcbf29ce484222325;
+                for (intmax_t x : {from.num, from.den, to.num, to.den})
+                    h = (h ^ static_cast<uint64_t>(x)) * 0x100000001b3;
+                return static_cast<size_t>(h ^ (h >> 32));
+
+            }
+
+            static std::array<entry, size>& table() noexcept {
+
+                thread_local std::array<entry, size> entries{};
+                return entries;
+
+            }
+
+
+        }; // struct conversion_cache
+
+
+        /// @brief Convert a number by an exact ratio, with the rules of 'scale': an integer ratio costs a multiplication,
+        ///        the inverse of an integer a division, any other ratio a single multiplication by its value.
+        /// @note  An integer is scaled by parts, (x / den) * num + (x % den) * num / den, so that x * num does not overflow before the division.
+        /// @throw 'std::overflow_error' if the integer converted does not fit in T.
+        template <typename T>
+            requires (std::is_arithmetic_v<T>)
+        constexpr T convert(const T& x, const rational& ratio) {
+
+            if constexpr (std::is_integral_v<T>) {
+
+                if (ratio.num == 1)
+                    return static_cast<T>(x / ratio.den);
+
+                T y;
+                intmax_t remainder = 0;
+                if (__builtin_mul_overflow(ratio.den == 1 ? x : x / ratio.den, ratio.num, &y) ||
+                    (ratio.den != 1 && (__builtin_mul_overflow(x % ratio.den, ratio.num, &remainder) ||
+                                        __builtin_add_overflow(y, remainder / ratio.den, &y))))
+                    throw std::overflow_error("Cannot convert the value of a dynamic quantity, the result overflows");
+                return y;
+
+            }
+            else if (ratio.den == 1)
+                return ratio.num == 1 ? x : static_cast<T>(x * static_cast<T>(ratio.num));
+            else if (ratio.num == 1)
+                return static_cast<T>(x / static_cast<T>(ratio.den));
+            else
+                return x * static_cast<T>(static_cast<long double>(ratio.num) / static_cast<long double>(ratio.den));
+
+        }
+
+
+        /// @brief This template meta-struct contains a quantity whose unit is known only at runtime.
+        /// @note  The operations check the dimensions when they are performed, throwing 'std::runtime_error' when they do not match.
+        ///        A static 'quantity' converts implicitly to it, and 'as' checks the unit once to get back to a static quantity,
+        ///        a copy of the value when the prefixes match.
+        /// @tparam T: the type of the value, a number
+        template <typename T>
+            requires (std::is_arithmetic_v<T>)
+        struct dynamic_quantity {
+
+
+            using value_t = T;
+
+
+            value_t value;
+
+            dynamic_unit unit;
+
+
+            constexpr dynamic_quantity() noexcept : value{}, unit{} {}
+
+            constexpr dynamic_quantity(const value_t& value, const dynamic_unit& unit) noexcept : value{value}, unit{unit} {}
+
+            /// @brief Constructor from a static quantity, whose unit is packed at compile time.
+            template <typename UNIT_T>
+            constexpr dynamic_quantity(const quantity<value_t, UNIT_T>& q) noexcept : value{q.value}, unit{dynamic_unit::of<UNIT_T>()} {}
+
+
+            /// @brief Check if the quantity has the base of the static unit UNIT_T.
+            template <typename UNIT_T>
+                requires (is_unit_v<UNIT_T>)
+            constexpr bool is() const noexcept {
+
+                return this->unit.template has_base<UNIT_T>();
+
+            }
+
+            /// @brief Get the static quantity of UNIT_T, converting the value to its prefix.
+            /// @throw 'std::runtime_error' if the quantity has not the base of UNIT_T.
+            template <typename UNIT_T>
+                requires (is_unit_v<UNIT_T>)
+            quantity<value_t, UNIT_T> as() const {
+
+                if (!this->is<UNIT_T>())
+                    throw std::runtime_error("Cannot convert a dynamic quantity to a unit of another base");
+
+                constexpr rational prefix = rational::of<typename UNIT_T::prefix_t>();
+                if (this->unit.prefix == prefix)
+                    return this->value;
+                return runtime::convert(this->value, conversion_cache::get(this->unit.prefix, prefix));
+
+            }
+
+            /// @brief Get the quantity converted to another unit with the same dimension.
+            dynamic_quantity to(const dynamic_unit& other) const {
+
+                if (!(this->unit.dimension == other.dimension))
+                    throw std::runtime_error("Cannot convert a dynamic quantity to a unit of another base");
+
+                return {runtime::convert(this->value, conversion_cache::get(this->unit.prefix, other.prefix)), other};
+
+            }
+
+
+        }; // struct dynamic_quantity
+
+
+    } // namespace runtime
+
+
+    using runtime::dynamic_unit;
+
+
+} // namespace ctda
@@ -0,0 +1,347 @@
+/**
+ * @file    ctda/core/expression.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the implementation of the lazy 'expression' struct.
+ * @date    2023-11-06
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    /// @brief Size of an operand of an expression, scalars are broadcasted.
+    template <typename T>
+    constexpr size_t expression_size(const T& x) noexcept {
+
+        if constexpr (is_expression_operand_v<T>)
+            return x.size();
+        else
+            return std::numeric_limits<size_t>::max();
+
+    }
+
+    /// @brief Element of an operand of an expression, scalars are broadcasted.
+    /// @note  The elements stored in reduced precision are converted to their compute type.
+    template <typename T>
+    constexpr decltype(auto) expression_at(const T& x, size_t i) noexcept {
+
+        if constexpr (is_expression_operand_v<T>) {
+            if constexpr (is_reduced_precision_v<std::remove_cvref_t<decltype(x[i])>>)
+                return static_cast<compute_t<std::remove_cvref_t<decltype(x[i])>>>(x[i]);
+            else
+                return x[i];
+        }
+        else
+            return (x);
+
+    }
+
+
+    /// @brief Operand of a block evaluation: a pointer to the block of the elements, or a broadcasted scalar.
+    /// @note  The blocks stored in reduced precision are widened into the buffer.
+    template <typename VALUE_T, typename T>
+    constexpr auto block_operand(const T& x, size_t i, size_t len, VALUE_T* buffer) noexcept {
+
+        if constexpr (is_expression_v<T>) {
+            x.eval_block(i, len, buffer);
+            return static_cast<const VALUE_T*>(buffer);
+        } 
+        else if constexpr (is_expression_operand_v<T>) {
+            if constexpr (is_reduced_precision_v<std::remove_cvref_t<decltype(*x.data())>>) {
+                math::simd::widen(x.data() + i, buffer, len);
+                return static_cast<const VALUE_T*>(buffer);
+            }
+            else
+                return x.data() + i;
+        }
+        else
+            return static_cast<VALUE_T>(x);
+
+    }
+
+
+    /// @brief Storage of an operand inside an expression: containers are referenced, nodes, views and scalars are copied.
+    template <typename T>
+    struct expression_operand {
+        using type = T;
+    };
+
+    template <typename T, typename ALLOC_T>
+    struct expression_operand<std::vector<T, ALLOC_T>> {
+        using type = const std::vector<T, ALLOC_T>&;
+    };
+
+    template <typename T>
+    using expression_operand_t = typename expression_operand<T>::type;
+
+
+    /// @brief Element type of an operand of an expression.
+    template <typename T>
+    struct expression_element {
+        using type = T;
+    };
+
+    template <typename T, typename ALLOC_T>
+    struct expression_element<std::vector<T, ALLOC_T>> {
+        using type = compute_t<T>;
+    };
+
+    template <typename T>
+    struct expression_element<std::span<T>> {
+        using type = compute_t<std::remove_cv_t<T>>;
+    };
+
+    template <typename OP_T, typename... ARGS_T>
+    struct expression_element<expression<OP_T, ARGS_T...>> {
+        using type = typename expression<OP_T, ARGS_T...>::value_type;
+    };
+
+    template <typename T>
+    using expression_element_t = typename expression_element<T>::type;
+
+
+    /// @brief Check if an operand can be evaluated by blocks with the SIMD kernels of an expression of VALUE_T.
+    template <typename T, typename VALUE_T>
+    struct is_block_operand : std::is_arithmetic<T> {};
+
+    template <typename T, typename ALLOC_T, typename VALUE_T>
+    struct is_block_operand<std::vector<T, ALLOC_T>, VALUE_T> : std::is_same<compute_t<T>, VALUE_T> {};
+
+    template <typename T, typename VALUE_T>
+    struct is_block_operand<std::span<T>, VALUE_T> : std::is_same<compute_t<std::remove_cv_t<T>>, VALUE_T> {};
+
+    template <typename OP_T, typename... ARGS_T, typename VALUE_T>
+    struct is_block_operand<expression<OP_T, ARGS_T...>, VALUE_T> 
+        : std::bool_constant<expression<OP_T, ARGS_T...>::vectorizable && 
+                             std::is_same_v<typename expression<OP_T, ARGS_T...>::value_type, VALUE_T>> {};
+
+    template <typename T, typename VALUE_T>
+    inline constexpr bool is_block_operand_v = is_block_operand<T, VALUE_T>::value;
+
+
+    /// @brief Allocator of an operand of an expression, void for the operands which do not own their elements.
+    template <typename T>
+    struct expression_allocator {
+        using type = void;
+    };
+
+    template <typename T, typename ALLOC_T>
+    struct expression_allocator<std::vector<T, ALLOC_T>> {
+        using type = ALLOC_T;
+    };
+
+    template <typename OP_T, typename... ARGS_T>
+    struct expression_allocator<expression<OP_T, ARGS_T...>> {
+        using type = typename expression<OP_T, ARGS_T...>::allocator_type;
+    };
+
+    template <typename T>
+    using expression_allocator_t = typename expression_allocator<T>::type;
+
+    /// @brief Allocator of the first operand of an expression owning its elements, the default one if none does.
+    template <typename VALUE_T, typename... ARGS_T>
+    struct first_allocator {
+        using type = std::allocator<VALUE_T>;
+    };
+
+    template <typename VALUE_T, typename T, typename... ARGS_T>
+    struct first_allocator<VALUE_T, T, ARGS_T...> {
+        using type = std::conditional_t<std::is_void_v<expression_allocator_t<T>>, 
+                                        typename first_allocator<VALUE_T, ARGS_T...>::type, 
+                                        expression_allocator_t<T>>;
+    };
+
+
+    /// @brief This template meta-struct is a node of a lazy element-wise expression over containers.
+    /// @note  Nothing is computed until the expression is assigned: then every element of the result
+    ///        is obtained in a single pass, without the allocation of intermediate containers.
+    ///        Containers are held by reference, so they must outlive the expression.
+    /// @tparam OP_T: functor applied to the elements of the operands
+    /// @tparam ARGS_T: operands of the expression (containers, expressions or scalars)
+    template <typename OP_T, typename... ARGS_T>
+    struct expression {
+
+
+        using value_type = std::remove_cvref_t<decltype(OP_T::f(std::declval<expression_element_t<ARGS_T>>()...))>;
+
+        using allocator_type = memory::rebind_alloc_t<typename first_allocator<value_type, ARGS_T...>::type, value_type>;
+
+        using result_t = std::vector<value_type, allocator_type>; //< container type of the evaluated expression
+
+        /// check if the expression can be evaluated by blocks with the SIMD kernels
+        static constexpr bool vectorizable = CTDA_USE_SIMD && OP_T::template vectorizable<value_type> && 
+                                             (is_block_operand_v<ARGS_T, value_type> && ...);
+
+        /// number of elements evaluated per block, small enough for the intermediate blocks to stay in cache
+        static constexpr size_t block_size = 256;
+
+
+        std::tuple<expression_operand_t<ARGS_T>...> args; //< operands of the expression
+
+        size_t n;                                         //< number of elements of the expression
+
+
+        /// @brief Constructor from the operands.
+        /// @param args: The operands of the expression.
+        constexpr expression(const ARGS_T&... args) : args{args...}, n{std::min({expression_size(args)...})} {
+
+            if (((expression_size(args) != this->n && !is_scalar_v<ARGS_T>) || ...))
+                throw std::runtime_error("Cannot operate on containers of different sizes");
+
+        }
+
+
+        /// @brief Get the number of elements of the expression.
+        constexpr size_t size() const noexcept {
+
+            return this->n;
+
+        }
+
+        /// @brief Compute the i-th element of the expression.
+        constexpr value_type operator[](size_t i) const noexcept {
+
+            return std::apply(
+                [i](const auto&... arg) {
+                    return OP_T::f(expression_at(arg, i)...);
+                },
+                this->args
+            );
+
+        }
+
+
+        /// @brief Get the allocator of the evaluated expression, derived from the first operand owning its elements.
+        template <size_t I = 0>
+        constexpr allocator_type get_allocator() const noexcept {
+
+            if constexpr (I == sizeof...(ARGS_T))
+                return memory::rebind_allocator<value_type>(allocator_type{});
+            else if constexpr (!std::is_void_v<expression_allocator_t<std::tuple_element_t<I, std::tuple<ARGS_T...>>>>)
+                return memory::rebind_allocator<value_type>(std::get<I>(this->args).get_allocator());
+            else
+                return this->get_allocator<I + 1>();
+
+        }
+
+
+        /// @brief Evaluate the elements [i, i + len) of the expression with the SIMD kernels.
+        /// @note  The intermediate nodes are evaluated in blocks on the stack, so no memory is allocated.
+        void eval_block(size_t i, size_t len, value_type* out) const noexcept 
+            requires (vectorizable) {
+
+            std::array<std::array<value_type, block_size>, sizeof...(ARGS_T)> buffers;
+
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                OP_T::block(out, len, block_operand(std::get<I>(this->args), i, len, buffers[I].data())...);
+            }(std::index_sequence_for<ARGS_T...>{});
+
+        }
+
+
+        /// @brief Evaluate the elements [begin, end) of the expression into a container.
+        /// @note  A container storing reduced precision elements receives blocks narrowed from the compute type.
+        template <typename CONTAINER_T>
+        constexpr void eval_range(CONTAINER_T& out, size_t begin, size_t end) const {
+
+            using element_t = std::remove_cvref_t<decltype(out[0])>;
+
+            if constexpr (vectorizable && std::is_same_v<element_t, value_type>) {
+                if !consteval {
+                    for (size_t i = begin; i < end; i += block_size)
+                        this->eval_block(i, std::min(block_size, end - i), out.data() + i);
+                    return;
+                }
+            }
+            else if constexpr (vectorizable && is_reduced_precision_v<element_t> && std::is_same_v<value_type, float>) {
+                if !consteval {
+                    std::array<value_type, block_size> buffer;
+                    for (size_t i = begin; i < end; i += block_size) {
+                        const size_t len = std::min(block_size, end - i);
+                        this->eval_block(i, len, buffer.data());
+                        math::simd::narrow(buffer.data(), out.data() + i, len);
+                    }
+                    return;
+                }
+            }
+
+            for (size_t i = begin; i < end; ++i)
+                out[i] = (*this)[i];
+
+        }
+
+        /// @brief Fit a container to the size of the expression: resizable containers are resized, 
+        ///        fixed-size containers and views must already have the right size.
+        template <typename CONTAINER_T>
+        constexpr void fit(CONTAINER_T& out) const {
+
+            if (out.size() == this->n)
+                return;
+
+            if constexpr (requires { out.resize(this->n); })
+                out.resize(this->n);
+            else
+                throw std::runtime_error("Cannot evaluate an expression into a container of a different size");
+
+        }
+
+        /// @brief Evaluate the expression into a container or a span in a single pass.
+        /// @note  The evaluation is element-wise, so the container can alias one of the operands.
+        template <typename CONTAINER_T>
+        constexpr void eval_into(CONTAINER_T& out) const {
+
+            this->fit(out);
+            this->eval_range(out, 0, this->n);
+
+        }
+
+        /// @brief Evaluate the expression into a container, splitting the elements among the threads of a pool.
+        template <typename CONTAINER_T, typename POOL_T>
+        void eval_into(CONTAINER_T& out, POOL_T& pool) const {
+
+            this->fit(out);
+            pool.parallel_for(this->n, 16 * block_size, [this, &out](size_t begin, size_t end) {
+                this->eval_range(out, begin, end);
+            });
+
+        }
+
+        /// @brief Evaluate the expression into a new container.
+        constexpr operator result_t() const {
+
+            result_t result(this->get_allocator());
+            this->eval_into(result);
+            return result;
+
+        }
+
+
+    }; // struct expression
+
+
+    /// @brief Type obtained evaluating T: the container of an expression, T itself otherwise.
+    template <typename T>
+    struct eval {
+        using type = T;
+    };
+
+    template <typename T>
+        requires (is_expression_v<T>)
+    struct eval<T> {
+        using type = typename T::result_t;
+    };
+
+    template <typename VALUE_T, typename UNIT_T>
+    struct eval<quantity<VALUE_T, UNIT_T>> {
+        using type = quantity<typename eval<VALUE_T>::type, UNIT_T>;
+    };
+
+    template <typename T>
+    using eval_t = typename eval<T>::type;
+
+
+} // namespace ctda
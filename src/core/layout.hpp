@@ -0,0 +1,127 @@
+/**
+ * @file    ctda/core/layout.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the layout guarantees of 'quantity' and 'measurement' and the bulk conversions from raw buffers.
+ * @date    2023-11-19
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    /// @brief This template meta-struct checks if a quantity has the layout of its value:
+    ///        same size and alignment, standard layout and trivially copyable.
+    template <typename T>
+    struct has_value_layout : std::false_type {};
+
+    template <typename VALUE_T, typename UNIT_T>
+    struct has_value_layout<quantity<VALUE_T, UNIT_T>>
+        : std::bool_constant<std::is_trivially_copyable_v<quantity<VALUE_T, UNIT_T>> &&
+                             std::is_standard_layout_v<quantity<VALUE_T, UNIT_T>> &&
+                             sizeof(quantity<VALUE_T, UNIT_T>) == sizeof(VALUE_T) &&
+                             alignof(quantity<VALUE_T, UNIT_T>) == alignof(VALUE_T)> {};
+
+    template <typename T>
+    inline constexpr bool has_value_layout_v = has_value_layout<T>::value;
+
+
+    static_assert(has_value_layout_v<quantity<double, unit<dimensionless>>>);
+    static_assert(has_value_layout_v<quantity<float, unit<dimensionless>>>);
+    static_assert(has_value_layout_v<quantity<std::complex<double>, unit<dimensionless>>>);
+    static_assert(std::is_trivially_copyable_v<measurement<quantity<double, unit<dimensionless>>>> &&
+                  std::is_standard_layout_v<measurement<quantity<double, unit<dimensionless>>>> &&
+                  sizeof(measurement<quantity<double, unit<dimensionless>>>) == 2 * sizeof(double));
+
+
+    /// @brief Get the n objects of T held by the storage of n objects of FROM_T with the same size, as an array.
+    /// @note  With 'std::start_lifetime_as_array' the objects of T begin their lifetime there, holding the bytes of the old ones.
+    ///        Without it, as with GCC 12, the pointer is only cast: this relies on GCC accessing the members of a quantity
+    ///        with the alias set of their own type, so that the values and the quantities that wrap them alias.
+    template <typename T, typename FROM_T>
+    inline T* reuse_as_array(FROM_T* p, [[maybe_unused]] size_t n) noexcept {
+
+        static_assert(std::is_standard_layout_v<std::remove_const_t<T>> && std::is_trivially_copyable_v<std::remove_const_t<T>> &&
+                      sizeof(T) == sizeof(FROM_T), "Cannot view a buffer as objects of another layout");
+
+        #ifdef __cpp_lib_start_lifetime_as
+            return std::start_lifetime_as_array<std::remove_const_t<T>>(p, n);
+        #else
+            return reinterpret_cast<T*>(p);
+        #endif
+
+    }
+
+
+    /// @brief View a buffer of values as a buffer of quantities of UNIT_T, without copying.
+    /// @note  The quantities share the storage of the values, so the span must not outlive the buffer.
+    template <typename UNIT_T, typename T, size_t EXTENT>
+        requires (is_unit_v<UNIT_T> && has_value_layout_v<quantity<std::remove_const_t<T>, UNIT_T>>)
+    inline std::span<std::conditional_t<std::is_const_v<T>, const quantity<std::remove_const_t<T>, UNIT_T>, quantity<std::remove_const_t<T>, UNIT_T>>, EXTENT>
+        as_quantities(std::span<T, EXTENT> values) noexcept {
+
+        using quantity_t = std::conditional_t<std::is_const_v<T>, const quantity<std::remove_const_t<T>, UNIT_T>, quantity<std::remove_const_t<T>, UNIT_T>>;
+        return {reuse_as_array<quantity_t>(values.data(), values.size()), values.size()};
+
+    }
+
+    /// @brief View a buffer of quantities as a buffer of their values, without copying.
+    template <typename QUANTITY_T, size_t EXTENT>
+        requires (has_value_layout_v<std::remove_const_t<QUANTITY_T>>)
+    inline auto as_values(std::span<QUANTITY_T, EXTENT> quantities) noexcept {
+
+        using value_t = typename std::remove_const_t<QUANTITY_T>::value_t;
+        using result_t = std::conditional_t<std::is_const_v<QUANTITY_T>, const value_t, value_t>;
+        return std::span<result_t, EXTENT>(reuse_as_array<result_t>(quantities.data(), quantities.size()), quantities.size());
+
+    }
+
+
+    /// @brief Copy a buffer of values into a buffer of quantities with a single memcpy.
+    template <typename T, size_t EXTENT, typename QUANTITY_T, size_t QUANTITY_EXTENT>
+        requires (has_value_layout_v<QUANTITY_T> && std::is_same_v<std::remove_const_t<T>, typename QUANTITY_T::value_t>)
+    inline void bulk_copy(std::span<T, EXTENT> values, std::span<QUANTITY_T, QUANTITY_EXTENT> quantities) {
+
+        if (values.size() != quantities.size())
+            throw std::runtime_error("Cannot copy buffers of different sizes");
+
+        std::memcpy(static_cast<void*>(quantities.data()), values.data(), values.size_bytes());
+
+    }
+
+    /// @brief Copy a buffer of quantities into a buffer of values with a single memcpy.
+    template <typename QUANTITY_T, size_t QUANTITY_EXTENT, typename T, size_t EXTENT>
+        requires (has_value_layout_v<std::remove_const_t<QUANTITY_T>> && std::is_same_v<T, typename std::remove_const_t<QUANTITY_T>::value_t>)
+    inline void bulk_copy(std::span<QUANTITY_T, QUANTITY_EXTENT> quantities, std::span<T, EXTENT> values) {
+
+        if (values.size() != quantities.size())
+            throw std::runtime_error("Cannot copy buffers of different sizes");
+
+        std::memcpy(values.data(), static_cast<const void*>(quantities.data()), values.size_bytes());
+
+    }
+
+
+    /// @brief Convert an array of values into an array of quantities of UNIT_T bit by bit.
+    template <typename UNIT_T, typename T, size_t N>
+        requires (is_unit_v<UNIT_T> && has_value_layout_v<quantity<T, UNIT_T>>)
+    constexpr std::array<quantity<T, UNIT_T>, N> as_quantities(const std::array<T, N>& values) noexcept {
+
+        return std::bit_cast<std::array<quantity<T, UNIT_T>, N>>(values);
+
+    }
+
+    /// @brief Convert an array of quantities into an array of their values bit by bit.
+    template <typename T, typename UNIT_T, size_t N>
+        requires (has_value_layout_v<quantity<T, UNIT_T>>)
+    constexpr std::array<T, N> as_values(const std::array<quantity<T, UNIT_T>, N>& quantities) noexcept {
+
+        return std::bit_cast<std::array<T, N>>(quantities);
+
+    }
+
+
+} // namespace ctda
@@ -13,12 +13,17 @@
 namespace ctda {
 
 
+    /// @brief This template meta-struct contains a physical measurement: a value and its uncertainty.
+    /// @note  When the value is a container, values and uncertainties are stored in two separate contiguous buffers.
+    /// @tparam The quantity measured.
     template <typename QUANTITY_T>
         requires (is_quantity_v<QUANTITY_T>)
     struct measurement {
 
         using value_t = QUANTITY_T::value_t;
         
+        using unit_t = QUANTITY_T::unit_t;
+
         using quantity_t = QUANTITY_T;
 
         using measurement_t = measurement<quantity_t>;
@@ -42,10 +47,33 @@ namespace ctda {
             return this->unc; 
         }
 
+
+        /// @brief Get the number of elements of the 'array-styled' measurement
+        constexpr size_t size() const noexcept {
+            return this->val.size();
+        }
+
+        /// @brief Access an element of the 'array-styled' measurement
+        constexpr auto operator[](size_t i) const noexcept {
+            return measurement<quantity<std::remove_cvref_t<decltype(this->val[i])>, unit_t>>(this->val[i], this->unc[i]);
+        }
+
+
         value_t val, unc;
 
 
     }; // struct measurement
 
 
-}
\ No newline at end of file
+    /// @brief Measurement of N elements stored as an array of values and an array of uncertainties
+    template <typename QUANTITY_T, size_t N>
+        requires (is_quantity_v<QUANTITY_T>)
+    using measurement_array = measurement<quantity<std::array<typename QUANTITY_T::value_t, N>, typename QUANTITY_T::unit_t>>;
+
+    /// @brief Measurement of a column stored as a vector of values and a vector of uncertainties
+    template <typename QUANTITY_T>
+        requires (is_quantity_v<QUANTITY_T>)
+    using measurement_vector = measurement<quantity<std::vector<typename QUANTITY_T::value_t>, typename QUANTITY_T::unit_t>>;
+
+
+} // namespace ctda
\ No newline at end of file
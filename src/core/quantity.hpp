@@ -40,25 +40,46 @@ namespace ctda {
         /// @param value: The value_t object to be stored in the quantity.
         constexpr quantity(value_t&& value) noexcept : value{std::move(value)} {}
 
-        /// @brief Copy constructor.
+        /// @brief Copy constructor, trivial when value_t is trivially copyable.
         /// @param other: The quantity to be copied.
-        constexpr quantity(const quantity& other) noexcept : value{other.value} {}
+        constexpr quantity(const quantity& other) = default;
 
-        /// @brief Move constructor.
+        /// @brief Move constructor, trivial when value_t is trivially copyable.
         /// @param other: The quantity to be moved.
-        constexpr quantity(quantity&& other) noexcept : value{std::move(other.value)} {}
+        constexpr quantity(quantity&& other) = default;
+
+        /// @brief Constructor from a lazy expression, evaluated in a single pass.
+        /// @param other: The quantity storing the expression.
+        template <typename EXPR_T>
+            requires (is_expression_v<EXPR_T>)
+        constexpr quantity(const quantity<EXPR_T, unit_t>& other) : value{memory::make_container<value_t>(other.value)} {
+
+            other.value.eval_into(this->value);
+
+        }
 
         /// @brief Destructor.
-        constexpr ~quantity() noexcept = default;
+        constexpr ~quantity() = default;
 
 
         /// @brief Copy assignment operator.
         /// @param other: The quantity to be copied.
-        constexpr quantity& operator=(const quantity& other) noexcept = default;
+        constexpr quantity& operator=(const quantity& other) = default;
 
         /// @brief Move assignment operator.
         /// @param other: The quantity to be moved.
-        constexpr quantity& operator=(quantity&& other) noexcept = default;
+        constexpr quantity& operator=(quantity&& other) = default;
+
+        /// @brief Assignment operator from a lazy expression, evaluated in place in a single pass.
+        /// @param other: The quantity storing the expression.
+        template <typename EXPR_T>
+            requires (is_expression_v<EXPR_T>)
+        constexpr quantity& operator=(const quantity<EXPR_T, unit_t>& other) {
+
+            other.value.eval_into(this->value);
+            return *this;
+
+        }
 
 
         #if CTDA_QUANTITY_ACCESS_W_CURVY_BRACKETS
@@ -13,6 +13,135 @@
 namespace ctda {
 
 
+    /// @brief This struct contains an exact positive rational number, the value of a prefix.
+    /// @note  As for 'std::ratio', it is kept reduced, and an operation whose result does not fit throws,
+    ///        which is a compile error when the result is the argument of a prefix.
+    struct rational {
+
+
+        intmax_t num = 1;
+
+        intmax_t den = 1;
+
+
+        /// @brief Get the reduced rational num / den.
+        static constexpr rational make(intmax_t num, intmax_t den) {
+
+            if (num <= 0 || den <= 0)
+                throw std::invalid_argument("Cannot build a prefix which is not positive");
+            const intmax_t g = std::gcd(num, den);
+            return {num / g, den / g};
+
+        }
+
+        template <typename RATIO_T>
+            requires (is_prefix_v<RATIO_T>)
+        static constexpr rational of() noexcept {
+
+            return {RATIO_T::num, RATIO_T::den};
+
+        }
+
+
+        friend constexpr rational operator*(const rational& x, const rational& y) {
+
+            const intmax_t g1 = std::gcd(x.num, y.den), g2 = std::gcd(y.num, x.den);
+            intmax_t num, den;
+            if (__builtin_mul_overflow(x.num / g1, y.num / g2, &num) || __builtin_mul_overflow(x.den / g2, y.den / g1, &den))
+                throw std::overflow_error("Cannot multiply prefixes, the result overflows");
+            return {num, den};
+
+        }
+
+        friend constexpr rational operator/(const rational& x, const rational& y) {
+
+            return x * rational{y.den, y.num};
+
+        }
+
+        /// @brief Get the rational raised to an integer power, by squaring.
+        constexpr rational pow(int p) const {
+
+            rational r, base = p < 0 ? rational{this->den, this->num} : *this;
+            for (unsigned k = p < 0 ? -static_cast<unsigned>(p) : static_cast<unsigned>(p); k != 0; k >>= 1) {
+                if (k & 1)
+                    r = r * base;
+                if (k > 1)
+                    base = base * base;
+            }
+            return r;
+
+        }
+
+        /// @brief Get the root of index p of the rational, exact: the roots of the numerator and of the denominator are found by bisection.
+        /// @throw 'std::domain_error' if they are not integers, as the square root of a kilo.
+        constexpr rational root(int p) const {
+
+            if (p == 0)
+                throw std::domain_error("Cannot take a root of index zero");
+            const unsigned k = p < 0 ? -static_cast<unsigned>(p) : static_cast<unsigned>(p);
+            const intmax_t num = integer_root(this->num, k), den = integer_root(this->den, k);
+            return p < 0 ? rational{den, num} : rational{num, den};
+
+        }
+
+        friend constexpr bool operator==(const rational& x, const rational& y) noexcept {
+
+            return x.num == y.num && x.den == y.den;
+
+        }
+
+
+      private:
+
+
+        /// @brief Get the integer r such that r^k == x, for x > 0.
+        static constexpr intmax_t integer_root(intmax_t x, unsigned k) {
+
+            // compare r^k with x
+            const auto compare = [x, k](intmax_t r) {
+                intmax_t y = 1;
+                for (unsigned i = 0; i < k; ++i)
+                    if (__builtin_mul_overflow(y, r, &y) || y > x)
+                        return std::strong_ordering::greater;
+                return y <=> x;
+            };
+
+            if (x <= 0)
+                throw std::domain_error("Cannot take the root of a prefix which is not positive");
+
+            intmax_t lo = 1, hi = x;
+            while (lo < hi) {
+                const intmax_t mid = hi - (hi - lo) / 2;
+                if (compare(mid) <= 0)
+                    lo = mid;
+                else
+                    hi = mid - 1;
+            }
+
+            if (compare(lo) != 0)
+                throw std::domain_error("Cannot take an exact root of the prefix");
+            return lo;
+
+        }
+
+
+    }; // struct rational
+
+
+    /// @brief The 'std::ratio' of an exact rational, computed by a constant expression instead of the recursive templates
+    ///        of 'std::ratio_multiply' and 'std::ratio_divide'.
+    template <rational R>
+    struct rational_ratio {
+
+        using type = std::ratio<R.num, R.den>;
+
+    };
+
+    template <rational R>
+    using rational_t = typename rational_ratio<R>::type;
+
+
     /// @brief  Struct unit is an union of a 'base_quantity' and an 'std::ratio' prefix
     /// @tparam BASE_TYPE: base_quantity
     /// @tparam PREFIX_TYPE: std::ratio
@@ -25,7 +154,7 @@ namespace ctda {
         using prefix_t = PREFIX_T;
 
 
-        static constexpr long double factor = static_cast<double>(prefix_t::num) / static_cast<double>(prefix_t::den);
+        static constexpr long double factor = static_cast<long double>(prefix_t::num) / static_cast<long double>(prefix_t::den);
 
     }; // struct unit
 
@@ -0,0 +1,156 @@
+/**
+ * @file    ctda/core/view.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the non-owning views of quantities over external memory.
+ * @date    2023-11-23
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    /// @brief Quantity referring to a contiguous buffer it does not own.
+    /// @note  The views are operands of the lazy expressions and can be their destination:
+    ///        assigning an expression writes through the view, assigning another view rebinds it like a 'std::span'.
+    template <typename T, typename UNIT_T, size_t EXTENT = std::dynamic_extent>
+    using quantity_view = quantity<std::span<T, EXTENT>, UNIT_T>;
+
+
+    /// @brief View a contiguous range of values as a quantity of UNIT_T.
+    template <typename UNIT_T, typename RANGE_T>
+        requires (is_unit_v<UNIT_T> && std::ranges::contiguous_range<RANGE_T> && std::ranges::borrowed_range<RANGE_T>)
+    constexpr auto as_view(RANGE_T&& values) noexcept {
+
+        return quantity_view<std::remove_reference_t<std::ranges::range_reference_t<RANGE_T>>, UNIT_T>(std::span(values));
+
+    }
+
+    /// @brief View the values of a quantity storing a contiguous range.
+    template <typename T>
+        requires (is_quantity_v<std::remove_cvref_t<T>> && std::is_lvalue_reference_v<T> &&
+                  std::ranges::contiguous_range<decltype((std::declval<T>().value))>)
+    constexpr auto as_view(T&& q) noexcept {
+
+        return as_view<typename std::remove_cvref_t<T>::unit_t>(q.value);
+
+    }
+
+
+    /// @brief This template meta-struct refers to a row-major multidimensional buffer it does not own.
+    /// @note  Shaped like a 'std::mdspan' with 'layout_right': 'x[i, j]' accesses an element and 'x[i]' a slice,
+    ///        while 'flat' gives the contiguous elements to the lazy expressions.
+    /// @tparam T: the type of the elements
+    /// @tparam RANK: the number of dimensions
+    template <typename T, size_t RANK>
+        requires (RANK > 0)
+    struct md_view {
+
+
+        using element_type = T;
+
+        using value_type = std::remove_cv_t<T>;
+
+
+        T* ptr = nullptr;                       //< first element
+
+        std::array<size_t, RANK> extents{};     //< extents of the dimensions
+
+
+        /// @brief Get the rank of the view.
+        static constexpr size_t rank() noexcept {
+
+            return RANK;
+
+        }
+
+        /// @brief Get the extent of a dimension.
+        constexpr size_t extent(size_t r) const noexcept {
+
+            return this->extents[r];
+
+        }
+
+        /// @brief Get the stride of a dimension.
+        constexpr size_t stride(size_t r) const noexcept {
+
+            size_t s = 1;
+            for (size_t i = r + 1; i < RANK; ++i)
+                s *= this->extents[i];
+            return s;
+
+        }
+
+        /// @brief Get the number of elements.
+        constexpr size_t size() const noexcept {
+
+            return this->stride(0) * this->extents[0];
+
+        }
+
+        constexpr T* data() const noexcept {
+
+            return this->ptr;
+
+        }
+
+        /// @brief Get the elements as a contiguous span.
+        constexpr std::span<T> flat() const noexcept {
+
+            return {this->ptr, this->size()};
+
+        }
+
+
+        /// @brief Access an element.
+        template <typename... INDICES_T>
+            requires (sizeof...(INDICES_T) == RANK && (std::is_convertible_v<INDICES_T, size_t> && ...))
+        constexpr T& operator[](INDICES_T... indices) const noexcept {
+
+            size_t offset = 0, r = 0;
+            ((offset = offset * this->extents[r++] + static_cast<size_t>(indices)), ...);
+            return this->ptr[offset];
+
+        }
+
+        /// @brief Access a slice along the first dimension.
+        constexpr auto operator[](size_t i) const noexcept
+            requires (RANK > 1) {
+
+            md_view<T, RANK - 1> slice{this->ptr + i * this->stride(0)};
+            std::copy(this->extents.begin() + 1, this->extents.end(), slice.extents.begin());
+            return slice;
+
+        }
+
+
+    }; // struct md_view
+
+
+    /// @brief Quantity referring to a row-major multidimensional buffer it does not own.
+    template <typename T, typename UNIT_T, size_t RANK>
+    using quantity_mdview = quantity<md_view<T, RANK>, UNIT_T>;
+
+
+    /// @brief View a contiguous buffer of values as a multidimensional quantity of UNIT_T.
+    template <typename UNIT_T, typename T, typename... EXTENTS_T>
+        requires (is_unit_v<UNIT_T> && sizeof...(EXTENTS_T) > 0 && (std::is_convertible_v<EXTENTS_T, size_t> && ...))
+    constexpr quantity_mdview<T, UNIT_T, sizeof...(EXTENTS_T)> as_mdview(T* data, EXTENTS_T... extents) noexcept {
+
+        return md_view<T, sizeof...(EXTENTS_T)>{data, {static_cast<size_t>(extents)...}};
+
+    }
+
+    /// @brief View the elements of a multidimensional quantity as a flat quantity, to compute expressions on them.
+    template <typename T, typename UNIT_T, size_t RANK>
+    constexpr quantity_view<T, UNIT_T> flat(const quantity_mdview<T, UNIT_T, RANK>& q) noexcept {
+
+        return q.value.flat();
+
+    }
+
+
+} // namespace ctda
@@ -0,0 +1,501 @@
+/**
+ * @file    format.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the compile-time unit labels, the 'to_chars' writers and the 'std::formatter' specializations.
+ * @date    2023-11-20
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    /// @brief Symbols of the SI prefixes, sorted by their power of ten.
+    inline constexpr std::array<std::pair<int, char>, 20> prefix_symbols = {{
+        {-24, 'y'}, //< yocto prefix
+        {-21, 'z'}, //< zepto prefix
+        {-18, 'a'}, //< atto prefix
+        {-15, 'f'}, //< femto prefix
+        {-12, 'p'}, //< pico prefix
+        {-9,  'n'}, //< nano prefix
+        {-6,  'u'}, //< micro prefix
+        {-3,  'm'}, //< milli prefix
+        {-2,  'c'}, //< centi prefix
+        {-1,  'd'}, //< deci prefix
+        {1,   'D'}, //< deca prefix
+        {2,   'h'}, //< hecto prefix
+        {3,   'k'}, //< kilo prefix
+        {6,   'M'}, //< mega prefix
+        {9,   'G'}, //< giga prefix
+        {12,  'T'}, //< tera prefix
+        {15,  'P'}, //< peta prefix
+        {18,  'E'}, //< exa prefix
+        {21,  'Z'}, //< zetta prefix
+        {24,  'Y'}  //< yotta prefix
+    }};
+
+
+    /// @brief Characters of a label built at compile time
+    struct label_buffer {
+
+        std::array<char, 128> data{};
+        size_t size = 0;
+
+        constexpr void append(char c) noexcept {
+            this->data[this->size++] = c;
+        }
+
+        constexpr void append(std::string_view s) noexcept {
+            for (char c : s)
+                this->append(c);
+        }
+
+        constexpr void append(intmax_t x) noexcept {
+
+            if (x < 0) {
+                this->append('-');
+                x = -x;
+            }
+
+            char digits[20]{};
+            size_t n = 0;
+            do {
+                digits[n++] = static_cast<char>('0' + x % 10);
+                x /= 10;
+            } while (x != 0);
+
+            while (n != 0)
+                this->append(digits[--n]);
+
+        }
+
+    };
+
+
+    /// @brief Power of ten of the ratio num / den, or 0 if the ratio is not an exact power of ten.
+    constexpr int exponent10(intmax_t num, intmax_t den) noexcept {
+
+        intmax_t x = den == 1 ? num : den;
+        if ((den != 1 && num != 1) || x <= 1)
+            return 0;
+
+        int e = 0;
+        for (; x % 10 == 0; x /= 10)
+            ++e;
+
+        return x == 1 ? (den == 1 ? e : -e) : 0;
+
+    }
+
+    template <typename RATIO_T>
+    constexpr int exponent10() noexcept {
+
+        return exponent10(RATIO_T::num, RATIO_T::den);
+
+    }
+
+
+    /// @brief Append the label of the powers of a base, powers[i] / power_den, with the prefix num / den.
+    /// @note  The prefix is written between brackets: its SI symbol if any, its exact ratio otherwise.
+    ///        A rational power is written as a ratio too, as in "m^1/2".
+    constexpr void append_label(label_buffer& label, const std::array<int, 7>& powers, int power_den, intmax_t num, intmax_t den) noexcept {
+
+        if (num != den) {
+
+            const int e = exponent10(num, den);
+            const auto symbol = std::ranges::find(prefix_symbols, e, &std::pair<int, char>::first);
+
+            label.append('(');
+            if (e != 0 && symbol != prefix_symbols.end())
+                label.append(symbol->second);
+            else if (e != 0) {
+                label.append("1e");
+                label.append(static_cast<intmax_t>(e));
+            }
+            else {
+                label.append(num);
+                if (den != 1) {
+                    label.append('/');
+                    label.append(den);
+                }
+            }
+            label.append(')');
+
+        }
+
+        bool first_term = true;
+        for (size_t i = 0; i < 7; ++i)
+            if (powers[i] != 0) {
+                if (!first_term)
+                    label.append(' ');
+                label.append(base_unit_literals[i]);
+                const int g = std::gcd(powers[i], power_den);
+                if (powers[i] != power_den) {
+                    label.append('^');
+                    label.append(static_cast<intmax_t>(powers[i] / g));
+                    if (power_den != g) {
+                        label.append('/');
+                        label.append(static_cast<intmax_t>(power_den / g));
+                    }
+                }
+                first_term = false;
+            }
+
+    }
+
+
+    /// @brief Build the label of a base with a prefix.
+    template <typename BASE_T, typename PREFIX_T>
+    constexpr label_buffer make_label() noexcept {
+
+        label_buffer label;
+        append_label(label, BASE_T::powers, BASE_T::den, PREFIX_T::num, PREFIX_T::den);
+        return label;
+
+    }
+
+
+    /// @brief This template meta-struct contains the label of a base or of a unit, computed at compile time.
+    template <typename T>
+        requires (is_base_v<T> || is_unit_v<T>)
+    struct unit_label {
+
+        static constexpr label_buffer buffer = [] {
+            if constexpr (is_unit_v<T>)
+                return make_label<typename T::base_t, typename T::prefix_t>();
+            else
+                return make_label<T, std::ratio<1>>();
+        }();
+
+        static constexpr std::string_view value{buffer.data.data(), buffer.size};
+
+    };
+
+    template <typename T>
+    inline constexpr std::string_view unit_label_v = unit_label<T>::value;
+
+
+    /// @brief Copy a string into [first, last).
+    inline std::to_chars_result to_chars(char* first, char* last, std::string_view s) noexcept {
+
+        if (static_cast<size_t>(last - first) < s.size())
+            return {last, std::errc::value_too_large};
+
+        std::memcpy(first, s.data(), s.size());
+        return {first + s.size(), std::errc{}};
+
+    }
+
+    template <typename T>
+        requires (std::is_arithmetic_v<T>)
+    std::to_chars_result to_chars(char* first, char* last, const T& x) noexcept;
+
+    template <typename T>
+        requires (is_reduced_precision_v<T>)
+    std::to_chars_result to_chars(char* first, char* last, const T& x) noexcept;
+
+    template <typename T>
+    std::to_chars_result to_chars(char* first, char* last, const std::complex<T>& z) noexcept;
+
+    template <typename T, size_t N>
+    std::to_chars_result to_chars(char* first, char* last, const std::array<T, N>& a) noexcept;
+
+    template <typename T, typename ALLOC_T>
+    std::to_chars_result to_chars(char* first, char* last, const std::vector<T, ALLOC_T>& v) noexcept;
+
+    template <typename T, size_t EXTENT>
+    std::to_chars_result to_chars(char* first, char* last, const std::span<T, EXTENT>& s) noexcept;
+
+    template <typename T, size_t RANK>
+    std::to_chars_result to_chars(char* first, char* last, const md_view<T, RANK>& v) noexcept;
+
+    template <typename T>
+        requires (is_expression_v<T>)
+    std::to_chars_result to_chars(char* first, char* last, const T& e) noexcept;
+
+    template <typename T>
+        requires (is_base_v<T> || is_unit_v<T>)
+    std::to_chars_result to_chars(char* first, char* last, const T&) noexcept;
+
+    template <typename T>
+        requires (is_quantity_v<T>)
+    std::to_chars_result to_chars(char* first, char* last, const T& q) noexcept;
+
+    template <typename T>
+        requires (is_measurement_v<T>)
+    std::to_chars_result to_chars(char* first, char* last, const T& m) noexcept;
+
+    inline std::to_chars_result to_chars(char* first, char* last, const dynamic_unit& u) noexcept;
+
+    template <typename T>
+    std::to_chars_result to_chars(char* first, char* last, const dynamic_quantity<T>& q) noexcept;
+
+
+    /// @brief Write a number with its shortest round-trip representation.
+    template <typename T>
+        requires (std::is_arithmetic_v<T>)
+    std::to_chars_result to_chars(char* first, char* last, const T& x) noexcept {
+
+        if constexpr (std::is_same_v<T, bool>)
+            return to_chars(first, last, x ? std::string_view("true") : std::string_view("false"));
+        else
+            return std::to_chars(first, last, x);
+
+    }
+
+    /// @brief Write a number stored in reduced precision through its compute type.
+    template <typename T>
+        requires (is_reduced_precision_v<T>)
+    std::to_chars_result to_chars(char* first, char* last, const T& x) noexcept {
+
+        return std::to_chars(first, last, static_cast<compute_t<T>>(x));
+
+    }
+
+    /// @brief Write a complex number as (real, imag).
+    template <typename T>
+    std::to_chars_result to_chars(char* first, char* last, const std::complex<T>& z) noexcept {
+
+        std::to_chars_result r = to_chars(first, last, std::string_view("("));
+        if (r.ec == std::errc{})
+            r = to_chars(r.ptr, last, z.real());
+        if (r.ec == std::errc{})
+            r = to_chars(r.ptr, last, std::string_view(", "));
+        if (r.ec == std::errc{})
+            r = to_chars(r.ptr, last, z.imag());
+        return r.ec == std::errc{} ? to_chars(r.ptr, last, std::string_view(")")) : r;
+
+    }
+
+    /// @brief Write the elements of a container between square brackets, rows of a matrix on separate lines.
+    template <typename CONTAINER_T>
+    std::to_chars_result to_chars_elements(char* first, char* last, const CONTAINER_T& c, size_t n) noexcept {
+
+        constexpr std::string_view separator = is_scalar_v<std::remove_cvref_t<decltype(c[0])>> ? " " : "\n";
+
+        std::to_chars_result r = to_chars(first, last, std::string_view("["));
+        for (size_t i = 0; i < n && r.ec == std::errc{}; ++i) {
+            if (i != 0)
+                r = to_chars(r.ptr, last, separator);
+            if (r.ec == std::errc{})
+                r = to_chars(r.ptr, last, c[i]);
+        }
+        return r.ec == std::errc{} ? to_chars(r.ptr, last, std::string_view("]")) : r;
+
+    }
+
+    template <typename T, size_t N>
+    std::to_chars_result to_chars(char* first, char* last, const std::array<T, N>& a) noexcept {
+
+        return to_chars_elements(first, last, a, N);
+
+    }
+
+    template <typename T, typename ALLOC_T>
+    std::to_chars_result to_chars(char* first, char* last, const std::vector<T, ALLOC_T>& v) noexcept {
+
+        return to_chars_elements(first, last, v, v.size());
+
+    }
+
+    template <typename T, size_t EXTENT>
+    std::to_chars_result to_chars(char* first, char* last, const std::span<T, EXTENT>& s) noexcept {
+
+        return to_chars_elements(first, last, s, s.size());
+
+    }
+
+    template <typename T, size_t RANK>
+    std::to_chars_result to_chars(char* first, char* last, const md_view<T, RANK>& v) noexcept {
+
+        return to_chars_elements(first, last, v, v.extent(0));
+
+    }
+
+    /// @brief Write the elements of a lazy expression, computed one by one without evaluating the whole expression.
+    template <typename T>
+        requires (is_expression_v<T>)
+    std::to_chars_result to_chars(char* first, char* last, const T& e) noexcept {
+
+        return to_chars_elements(first, last, e, e.size());
+
+    }
+
+    /// @brief Write the label of a base or of a unit.
+    template <typename T>
+        requires (is_base_v<T> || is_unit_v<T>)
+    std::to_chars_result to_chars(char* first, char* last, const T&) noexcept {
+
+        return to_chars(first, last, unit_label_v<T>);
+
+    }
+
+    /// @brief Write a quantity as its value followed by the label of its unit.
+    template <typename T>
+        requires (is_quantity_v<T>)
+    std::to_chars_result to_chars(char* first, char* last, const T& q) noexcept {
+
+        std::to_chars_result r = to_chars(first, last, q.value);
+        if (r.ec != std::errc{} || unit_label_v<typename T::unit_t>.empty())
+            return r;
+
+        r = to_chars(r.ptr, last, std::string_view(" "));
+        return r.ec == std::errc{} ? to_chars(r.ptr, last, unit_label_v<typename T::unit_t>) : r;
+
+    }
+
+    /// @brief Write a measurement as its value and its uncertainty.
+    template <typename T>
+        requires (is_measurement_v<T>)
+    std::to_chars_result to_chars(char* first, char* last, const T& m) noexcept {
+
+        std::to_chars_result r = to_chars(first, last, m.value());
+        if (r.ec == std::errc{})
+            r = to_chars(r.ptr, last, std::string_view(" +- "));
+        return r.ec == std::errc{} ? to_chars(r.ptr, last, m.uncertainty()) : r;
+
+    }
+
+
+    /// @brief Write the label of a unit known at runtime, built like the compile-time ones.
+    inline std::to_chars_result to_chars(char* first, char* last, const dynamic_unit& u) noexcept {
+
+        label_buffer label;
+        append_label(label, u.dimension.powers(), u.dimension.den(), u.prefix.num, u.prefix.den);
+        return to_chars(first, last, std::string_view(label.data.data(), label.size));
+
+    }
+
+    /// @brief Write a quantity whose unit is known at runtime as its value followed by the label of its unit.
+    template <typename T>
+    std::to_chars_result to_chars(char* first, char* last, const dynamic_quantity<T>& q) noexcept {
+
+        std::to_chars_result r = to_chars(first, last, q.value);
+        if (r.ec != std::errc{} || q.unit == dynamic_unit{})
+            return r;
+
+        r = to_chars(r.ptr, last, std::string_view(" "));
+        return r.ec == std::errc{} ? to_chars(r.ptr, last, q.unit) : r;
+
+    }
+
+
+    /// @brief Get the text written by 'to_chars' as a string, growing the buffer until it fits.
+    template <typename T>
+    std::string to_chars_string(const T& x) {
+
+        std::string s(64, '\0');
+        while (true) {
+
+            const std::to_chars_result r = to_chars(s.data(), s.data() + s.size(), x);
+            if (r.ec == std::errc{}) {
+                s.resize(static_cast<size_t>(r.ptr - s.data()));
+                return s;
+            }
+            s.resize(2 * s.size());
+
+        }
+
+    }
+
+
+    /// @brief Write the values of a container quantity into a buffer, each one followed by 'separator' and without the unit.
+    /// @note  Meant for the bulk export of columns, for example to CSV: the unit label belongs to the header.
+    /// @return The end of the text written, or 'value_too_large' with the position of the first value not written.
+    template <typename T>
+        requires (is_quantity_v<T> && std::ranges::random_access_range<typename T::value_t>)
+    std::to_chars_result write_column(std::span<char> buffer, const T& q, char separator = '\n') noexcept {
+
+        char* first = buffer.data();
+        char* const last = buffer.data() + buffer.size();
+
+        for (const auto& x : q.value) {
+
+            const std::to_chars_result r = to_chars(first, last, x);
+            if (r.ec != std::errc{} || r.ptr == last)
+                return {first, std::errc::value_too_large};
+
+            *r.ptr = separator;
+            first = r.ptr + 1;
+
+        }
+
+        return {first, std::errc{}};
+
+    }
+
+
+} // namespace ctda
+
+
+#ifdef __cpp_lib_format
+
+
+/// @brief Formatter of the quantities with a numeric value, the format specification applies to the value.
+template <typename VALUE_T, typename UNIT_T>
+    requires (std::is_arithmetic_v<VALUE_T>)
+struct std::formatter<ctda::quantity<VALUE_T, UNIT_T>, char> : std::formatter<VALUE_T, char> {
+
+    template <typename CONTEXT_T>
+    auto format(const ctda::quantity<VALUE_T, UNIT_T>& q, CONTEXT_T& ctx) const {
+
+        auto out = std::formatter<VALUE_T, char>::format(q.value, ctx);
+        if constexpr (!ctda::unit_label_v<UNIT_T>.empty()) {
+            *out++ = ' ';
+            out = std::ranges::copy(ctda::unit_label_v<UNIT_T>, out).out;
+        }
+        return out;
+
+    }
+
+};
+
+/// @brief Formatter of the quantities with a container value, written as by 'to_chars'.
+template <typename VALUE_T, typename UNIT_T>
+    requires (!std::is_arithmetic_v<VALUE_T>)
+struct std::formatter<ctda::quantity<VALUE_T, UNIT_T>, char> : std::formatter<std::string_view, char> {
+
+    template <typename CONTEXT_T>
+    auto format(const ctda::quantity<VALUE_T, UNIT_T>& q, CONTEXT_T& ctx) const {
+
+        return std::formatter<std::string_view, char>::format(ctda::to_chars_string(q), ctx);
+
+    }
+
+};
+
+/// @brief Formatter of the measurements with a numeric value, the format specification applies to the value and to the uncertainty.
+template <typename VALUE_T, typename UNIT_T>
+    requires (std::is_arithmetic_v<VALUE_T>)
+struct std::formatter<ctda::measurement<ctda::quantity<VALUE_T, UNIT_T>>, char> : std::formatter<ctda::quantity<VALUE_T, UNIT_T>, char> {
+
+    template <typename CONTEXT_T>
+    auto format(const ctda::measurement<ctda::quantity<VALUE_T, UNIT_T>>& m, CONTEXT_T& ctx) const {
+
+        ctx.advance_to(std::formatter<ctda::quantity<VALUE_T, UNIT_T>, char>::format(m.value(), ctx));
+        ctx.advance_to(std::ranges::copy(std::string_view(" +- "), ctx.out()).out);
+        return std::formatter<ctda::quantity<VALUE_T, UNIT_T>, char>::format(m.uncertainty(), ctx);
+
+    }
+
+};
+
+/// @brief Formatter of the bases and of the units, written with their compile-time label.
+template <typename T>
+    requires (ctda::is_base_v<T> || ctda::is_unit_v<T>)
+struct std::formatter<T, char> : std::formatter<std::string_view, char> {
+
+    template <typename CONTEXT_T>
+    auto format(const T&, CONTEXT_T& ctx) const {
+
+        return std::formatter<std::string_view, char>::format(ctda::unit_label_v<T>, ctx);
+
+    }
+
+};
+
+
+#endif
@@ -16,9 +16,7 @@ namespace std {
     template <typename T>
     constexpr string to_string(const complex<T>& z) noexcept {
             
-        stringstream ss;
-        ss << '(' << z.real() << ", " << z.imag() << ')';
-        return ss.str();
+        return ctda::to_chars_string(z);
 
     }
 
@@ -27,36 +25,25 @@ namespace std {
         requires (is_arithmetic_v<T>)
     constexpr string to_string(const array<T, N>& a) noexcept {
 
-        stringstream ss;
+        return ctda::to_chars_string(a);
 
-        ss << '[';
-        for (size_t i = 0; i < N; ++i) {
-            ss << to_string(a[i]); 
-            if (i != N - 1) 
-               ss << ' ';
-        }
-        ss << ']';
+    }
 
-        return ss.str();
 
-    }
+    template <typename T, typename ALLOC_T>
+    constexpr string to_string(const vector<T, ALLOC_T>& a) noexcept {
 
+        return ctda::to_chars_string(a);
 
-    template <typename T>
-    constexpr string to_string(const vector<T>& a) noexcept {
+    }
 
-        stringstream ss;
-        const size_t N = a.size();
 
-        ss << '[';
-        for (size_t i = 0; i < N; ++i) {
-            ss << to_string(a[i]);
-            if (i != N - 1) 
-               ss << ' ';
-        }
-        ss << ']';
+    /// @brief Get a string representation of the expression, computed element by element.
+    template <typename T>
+        requires (ctda::is_expression_v<T>)
+    constexpr string to_string(const T& e) noexcept {
 
-        return ss.str();
+        return ctda::to_chars_string(e);
 
     }
 
@@ -64,19 +51,7 @@ namespace std {
     template <typename T, size_t N, size_t M>
     constexpr string to_string(const array<array<T, N>, M>& a) noexcept {
 
-        stringstream ss;
-
-        ss << '[';
-
-        for (size_t i = 0; i < M; ++i) {
-            ss << to_string(a[i]);
-            if (i != M - 1)
-                ss << '\n';
-        }
-
-        ss << ']';
-
-        return ss.str();
+        return ctda::to_chars_string(a);
 
     }
 
@@ -85,86 +60,16 @@ namespace std {
         requires (ctda::is_base_v<T>)
     constexpr string to_string(const T&) noexcept{
 
-        stringstream ss;
-
-        // To track the first term to handle spacing
-        bool first_term = true;  
-
-        // Iterate over the base quantities and their powers
-        for (int i = 0; i < 7; ++i) 
-
-            if (T::powers[i] != 0) {
-                if (!first_term) // Add a space between terms
-                    ss << ' ';
-                if (T::powers[i] != 1) // Add the power if not 1
-                    ss << ctda::base_unit_literals[i] << '^' << T::powers[i]; 
-                else 
-                    ss << ctda::base_unit_literals[i]; 
-
-                first_term = false;
-            }
-
-        return ss.str();    
+        return string(ctda::unit_label_v<T>);
 
     }        
 
 
-    /// @brief The prefix map contains factor and char representation of the SI prefixes.
-    inline static constexpr auto prefix_map = array<pair<int, char>, 20>(
-        {
-            {-24, 'y'}, //< yocto prefix
-            {-21, 'z'}, //< zepto prefix
-            {-18, 'a'}, //< atto prefix
-            {-15, 'f'}, //< femto prefix
-            {-12, 'p'}, //< pico prefix
-            {-9,  'n'}, //< nano prefix
-            {-6,  'u'}, //< micro prefix
-            {-3,  'm'}, //< milli prefix
-            {-2,  'c'}, //< centi prefix
-            {-1,  'd'}, //< deci prefix
-            {1,   'D'}, //< deca prefix
-            {2,   'h'}, //< hecto prefix
-            {3,   'k'}, //< kilo prefix
-            {6,   'M'}, //< mega prefix
-            {9,   'G'}, //< giga prefix
-            {12,  'T'}, //< tera prefix
-            {15,  'P'}, //< peta prefix
-            {18,  'E'}, //< exa prefix
-            {21,  'Z'}, //< zetta prefix
-            {24,  'Y'} //< yotta prefix
-
-        }
-    ); 
-
-
     template <typename T>
         requires (ctda::is_unit_v<T>)
     constexpr string to_string(const T&) noexcept {
 
-        stringstream ss;
-
-        constexpr auto digits = static_cast<int>(log10(T::factor));
-
-        if constexpr (digits < -24 || digits > 24) 
-            throw runtime_error("Prefix out of range.");
-
-        if constexpr (digits != 0) {
-
-            constexpr auto prefix = lower_bound(
-                prefix_map.begin(), prefix_map.end(), 
-                digits,
-                [](const auto& p, const auto& value) { 
-                    return p.first < value; 
-                }
-            );
-            
-            ss << '(' << prefix->second << ')'; 
-            
-        }
-
-        ss << to_string(typename T::base_t{});
-
-        return ss.str();
+        return string(ctda::unit_label_v<T>);
         
     }
 
@@ -174,7 +79,7 @@ namespace std {
         requires (ctda::is_quantity_v<T>)
     constexpr string to_string(const T& q) noexcept {
 
-        return to_string(q.value) + ' ' + to_string(typename T::unit_t{});
+        return ctda::to_chars_string(q);
 
     }
 
@@ -184,7 +89,7 @@ namespace std {
         requires (ctda::is_measurement_v<T>)
     constexpr string to_string(const T& m) noexcept {
 
-        return to_string(m.value()) + " +- " + to_string(m.uncertainty());
+        return ctda::to_chars_string(m);
 
     }
 
@@ -43,6 +43,85 @@ namespace ctda {
         };        
 
 
+        /// @brief Add specialization for dual numbers
+        template <typename T, size_t N>
+        struct add_impl<dual<T, N>, dual<T, N>> {
+
+            using result_t = dual<T, N>;
+
+            static constexpr result_t f(const dual<T, N>& a, const dual<T, N>& b) noexcept {
+                return {a.val + b.val, a.d + b.d};
+            }
+
+        };
+
+        /// @brief Add specialization for dual numbers and numbers
+        template <typename T, size_t N, typename T2>
+            requires (std::is_arithmetic_v<T2>)
+        struct add_impl<dual<T, N>, T2> {
+
+            using result_t = dual<T, N>;
+
+            static constexpr result_t f(const dual<T, N>& a, const T2& b) noexcept {
+                return {a.val + static_cast<T>(b), a.d};
+            }
+
+        };
+
+        template <typename T1, typename T, size_t N>
+            requires (std::is_arithmetic_v<T1>)
+        struct add_impl<T1, dual<T, N>> {
+
+            using result_t = dual<T, N>;
+
+            static constexpr result_t f(const T1& a, const dual<T, N>& b) noexcept {
+                return {static_cast<T>(a) + b.val, b.d};
+            }
+
+        };
+
+
+        /// @brief Add specialization for complex vectors, computed plane by plane
+        template <typename T, typename ALLOC_T>
+        struct add_impl<complex_vector<T, ALLOC_T>, complex_vector<T, ALLOC_T>> {
+
+            using result_t = complex_vector<T, ALLOC_T>;
+
+            static result_t f(const complex_vector<T, ALLOC_T>& a, const complex_vector<T, ALLOC_T>& b) {
+
+                if (a.size() != b.size())
+                    throw std::runtime_error("Cannot add vectors of different sizes");
+
+                result_t result(a.size(), memory::rebind_allocator<T>(a.get_allocator()));
+                simd::binary<simd::op::add>(a.re.data(), b.re.data(), result.re.data(), a.size());
+                simd::binary<simd::op::add>(a.im.data(), b.im.data(), result.im.data(), a.size());
+                return result;
+
+            }
+
+        };
+
+
+        /// @brief Add specialization for dynamic quantities, in the unit of the first one
+        /// @note  The dimensions are compared at runtime: the second quantity is converted to the unit of the first one
+        ///        if they have the same dimension, otherwise 'std::runtime_error' is thrown.
+        template <typename T1, typename T2>
+        struct add_impl<dynamic_quantity<T1>, dynamic_quantity<T2>> {
+
+            using result_t = dynamic_quantity<std::common_type_t<T1, T2>>;
+
+            static result_t f(const dynamic_quantity<T1>& a, const dynamic_quantity<T2>& b) {
+
+                if (!(a.unit.dimension == b.unit.dimension))
+                    throw std::runtime_error("Cannot add quantities of different dimensions");
+
+                return {a.value + b.to(a.unit).value, a.unit};
+
+            }
+
+        };
+
+
         /// @brief Add specialization for array
         template <typename T1, typename T2, size_t N>
         struct add_impl<std::array<T1, N>, std::array<T2, N>> {
@@ -52,6 +131,14 @@ namespace ctda {
             static constexpr result_t f(const std::array<T1, N>& a, const std::array<T2, N>& b) noexcept {
                 
                 result_t result{};
+
+                if constexpr (std::is_same_v<T1, T2> && simd::use_kernel_v<T1, N>) {
+                    if !consteval {
+                        simd::binary<simd::op::add>(a.data(), b.data(), result.data(), N);
+                        return result;
+                    }
+                }
+
                 for (size_t i = 0; i < N; ++i) 
                     result[i] = a[i] + b[i];
                 return result;
@@ -61,17 +148,19 @@ namespace ctda {
         };
 
 
-        template <typename T1, typename T2>
-        struct add_impl<std::vector<T1>, std::vector<T2>> {
+        /// @brief Add specialization for vectors of non scalar types
+        template <typename T1, typename ALLOC1_T, typename T2, typename ALLOC2_T>
+            requires (!are_expression_operand_v<std::vector<T1, ALLOC1_T>, std::vector<T2, ALLOC2_T>>)
+        struct add_impl<std::vector<T1, ALLOC1_T>, std::vector<T2, ALLOC2_T>> {
 
-            using result_t = std::vector<std::common_type_t<T1, T2>>;
+            using result_t = std::vector<std::common_type_t<T1, T2>, memory::rebind_alloc_t<ALLOC1_T, std::common_type_t<T1, T2>>>;
 
-            static constexpr result_t f(const std::vector<T1>& a, const std::vector<T2>& b) {
+            static constexpr result_t f(const std::vector<T1, ALLOC1_T>& a, const std::vector<T2, ALLOC2_T>& b) {
                 
                 if (a.size() != b.size())
                     throw std::runtime_error("Cannot add vectors of different sizes");
 
-                result_t result(a.size());
+                result_t result(a.size(), memory::rebind_allocator<std::common_type_t<T1, T2>>(a.get_allocator()));
                 for (size_t i = 0; i < a.size(); ++i) 
                     result[i] = a[i] + b[i];
                 return result;
@@ -81,6 +170,20 @@ namespace ctda {
         };
         
 
+        /// @brief Add specialization for vectors and expressions, evaluated lazily
+        template <typename T1, typename T2>
+            requires (are_expression_operand_v<T1, T2>)
+        struct add_impl<T1, T2> {
+
+            using result_t = expression<add_op, T1, T2>;
+
+            static constexpr result_t f(const T1& a, const T2& b) {
+                return {a, b};
+            }                                             
+
+        };
+        
+
         // /// @brief Add specialization for numbers and arrays
         // template <typename T1, typename T2, size_t N>
         //     requires (std::is_arithmetic_v<T1>)
@@ -122,14 +225,15 @@ namespace ctda {
             requires (are_same_quantity_v<T1, T2>)
         struct add_impl<T1, T2> {
 
-            using result_t = quantity<add_t<typename T1::value_t, typename T2::value_t>, typename T1::unit_t>;
+            using result_t = quantity<add_t<typename T1::value_t, scale_t<conversion_t<typename T2::unit_t, typename T1::unit_t>, typename T2::value_t>>, 
+                                      typename T1::unit_t>;
 
-            static constexpr result_t f(const T1& x, const T2& y) noexcept {
+            static constexpr result_t f(const T1& x, const T2& y) {
 
                 if constexpr (std::is_same_v<typename T1::unit_t, typename T2::unit_t>) 
                     return x.value + y.value;
                 else
-                    return x.value + y.value * conversion_factor(typename T1::unit_t{}, typename T2::unit_t{});
+                    return add(x.value, scale<conversion_t<typename T2::unit_t, typename T1::unit_t>>(y.value));
 
             }
 
@@ -169,11 +273,12 @@ namespace ctda {
             requires (are_same_quantity_v<T1, T2>)
         struct add_impl<measurement<T1>, measurement<T2>> {
 
-            using result_t = measurement<quantity<add_t<typename T1::value_t, typename T2::value_t>, typename T1::unit_t>>;
+            using result_t = measurement<quantity<eval_t<add_t<typename T1::value_t, typename T2::value_t>>, typename T1::unit_t>>;
 
-            static constexpr result_t f(const measurement<T1>& x, const measurement<T2>& y) noexcept {
+            static constexpr result_t f(const measurement<T1>& x, const measurement<T2>& y) {
                 
-                return { x.val + y.val, math::sqrt(math::sq(x.unc) + math::sq(y.unc)) };
+                using ratio_t = conversion_t<typename T2::unit_t, typename T1::unit_t>;
+                return { add(x.val, scale<ratio_t>(y.val)), sqrt(add(sq(x.unc), sq(scale<ratio_t>(y.unc)))) };
 
             }
 
@@ -207,6 +312,52 @@ namespace ctda {
         };
 
 
+        /// @brief Add-assign specialization for arrays, computed in place
+        template <typename T1, typename T2, size_t N>
+        struct add_assign_impl<std::array<T1, N>, std::array<T2, N>> {
+
+            static constexpr void f(std::array<T1, N>& x, const std::array<T2, N>& y) noexcept {
+
+                if constexpr (std::is_same_v<T1, T2> && simd::use_kernel_v<T1, N>) {
+                    if !consteval {
+                        simd::binary<simd::op::add>(x.data(), y.data(), x.data(), N);
+                        return;
+                    }
+                }
+
+                for (size_t i = 0; i < N; ++i)
+                    add_assign(x[i], y[i]);
+
+            }
+
+        };
+
+
+        /// @brief Add-assign specialization for vectors and spans, evaluated in place in a single pass
+        /// @note  The evaluation is element-wise, so y can be an expression referring to x.
+        template <typename T1, typename T2>
+            requires (is_expression_operand_v<T1> && !is_expression_v<T1> && is_expression_v<add_t<T1, T2>>)
+        struct add_assign_impl<T1, T2> {
+
+            static constexpr void f(T1& x, const T2& y) {
+                add(x, y).eval_into(x);
+            }
+
+        };
+
+
+        /// @brief Add-assign specialization for quantities, computed in place in the unit of x
+        template <typename T1, typename T2>
+            requires (are_same_quantity_v<T1, T2>)
+        struct add_assign_impl<T1, T2> {
+
+            static constexpr void f(T1& x, const T2& y) {
+                add_assign(x.value, scale<conversion_t<typename T2::unit_t, typename T1::unit_t>>(y.value));
+            }
+
+        };
+
+
     } // namespace math
 
 
@@ -0,0 +1,367 @@
+/**
+ * @file    math/algebraic/divide.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the implementation of the divide struct.
+ * @date    2023-11-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#pragma once
+
+
+namespace ctda {
+
+
+    namespace math {
+
+
+        /// @brief Divide specialization for base_quantities
+        template <typename T1, typename T2>
+            requires (are_base_v<T1, T2>)
+        struct divide_impl<T1, T2> {
+
+            using result_t = packed_base<(dimension{T1::packed} / dimension{T2::packed}).bits>;
+
+            static constexpr result_t f(const T1&, const T2&) noexcept {
+                return {};
+            }
+
+        };
+
+
+        /// @brief Divide specialization for prefixes
+        template <typename T1, typename T2>
+            requires (are_prefix_v<T1, T2>)
+        struct divide_impl<T1, T2> {
+
+            using result_t = rational_t<rational{T1::num, T1::den} / rational{T2::num, T2::den}>;
+
+            static constexpr result_t f(const T1&, const T2&) noexcept {
+                return {};
+            }
+
+        };
+
+
+        /// @brief Divide specialization for units, with the base and the prefix computed in place
+        template <typename T1, typename T2>
+            requires (are_unit_v<T1, T2>)
+        struct divide_impl<T1, T2> {
+
+            using result_t = unit<packed_base<(dimension{T1::base_t::packed} / dimension{T2::base_t::packed}).bits>,
+                                  rational_t<rational{T1::prefix_t::num, T1::prefix_t::den} / rational{T2::prefix_t::num, T2::prefix_t::den}>>;
+
+            static constexpr result_t f(const T1&, const T2&) noexcept {
+                return {};
+            }
+
+        };
+
+
+        /// @brief Divide specialization for numbers
+        /// @note  The division of two integers is not truncated.
+        template <typename T1, typename T2>
+            requires (std::is_arithmetic_v<T1> && std::is_arithmetic_v<T2>)
+        struct divide_impl<T1, T2> {
+
+            using result_t = std::conditional_t<std::is_integral_v<T1> && std::is_integral_v<T2>, double, std::common_type_t<T1, T2>>;
+
+            static constexpr result_t f(const T1& a, const T2& b) noexcept {
+                return static_cast<result_t>(a) / static_cast<result_t>(b);
+            }
+
+        };
+
+
+        /// @brief Divide specialization for complex numbers
+        template <typename T1, typename T2>
+        struct divide_impl<std::complex<T1>, std::complex<T2>> {
+
+            using result_t = std::complex<std::common_type_t<T1, T2>>;
+
+            static constexpr result_t f(const std::complex<T1>& a, const std::complex<T2>& b) noexcept {
+                return static_cast<result_t>(a) / static_cast<result_t>(b);
+            }
+
+        };
+
+
+        /// @brief Divide specialization for dual numbers, the quotient rule applied to all the tangents at once
+        template <typename T, size_t N>
+        struct divide_impl<dual<T, N>, dual<T, N>> {
+
+            using result_t = dual<T, N>;
+
+            static constexpr result_t f(const dual<T, N>& a, const dual<T, N>& b) noexcept {
+
+                const T r = a.val / b.val;
+                return {r, (a.d - b.d * r) / b.val};
+
+            }
+
+        };
+
+        /// @brief Divide specialization for dual numbers and numbers
+        template <typename T, size_t N, typename T2>
+            requires (std::is_arithmetic_v<T2>)
+        struct divide_impl<dual<T, N>, T2> {
+
+            using result_t = dual<T, N>;
+
+            static constexpr result_t f(const dual<T, N>& a, const T2& b) noexcept {
+                return {a.val / static_cast<T>(b), a.d / static_cast<T>(b)};
+            }
+
+        };
+
+
+        /// @brief Divide specialization for dynamic quantities: the packed powers of the units are subtracted at once
+        template <typename T1, typename T2>
+        struct divide_impl<dynamic_quantity<T1>, dynamic_quantity<T2>> {
+
+            using result_t = dynamic_quantity<std::common_type_t<T1, T2>>;
+
+            static constexpr result_t f(const dynamic_quantity<T1>& a, const dynamic_quantity<T2>& b) {
+                return {a.value / b.value, a.unit / b.unit};
+            }
+
+        };
+
+        /// @brief Divide specialization for dynamic quantities and numbers
+        template <typename T1, typename T2>
+            requires (std::is_arithmetic_v<T2>)
+        struct divide_impl<dynamic_quantity<T1>, T2> {
+
+            using result_t = dynamic_quantity<std::common_type_t<T1, T2>>;
+
+            static constexpr result_t f(const dynamic_quantity<T1>& a, const T2& b) noexcept {
+                return {a.value / b, a.unit};
+            }
+
+        };
+
+
+        /// @brief Divide specialization for arrays
+        template <typename T1, typename T2, size_t N>
+        struct divide_impl<std::array<T1, N>, std::array<T2, N>> {
+
+            using result_t = std::array<divide_t<T1, T2>, N>;
+
+            static constexpr result_t f(const std::array<T1, N>& a, const std::array<T2, N>& b) noexcept {
+
+                result_t result{};
+
+                if constexpr (std::is_same_v<T1, T2> && simd::use_kernel_v<T1, N>) {
+                    if !consteval {
+                        simd::binary<simd::op::div>(a.data(), b.data(), result.data(), N);
+                        return result;
+                    }
+                }
+
+                for (size_t i = 0; i < N; ++i)
+                    result[i] = div(a[i], b[i]);
+                return result;
+
+            }
+
+        };
+
+
+        /// @brief Divide specialization for arrays and numbers
+        template <typename T1, size_t N, typename T2>
+            requires (is_scalar_v<T2>)
+        struct divide_impl<std::array<T1, N>, T2> {
+
+            using result_t = std::array<divide_t<T1, T2>, N>;
+
+            static constexpr result_t f(const std::array<T1, N>& a, const T2& b) noexcept {
+
+                result_t result{};
+
+                if constexpr (std::is_arithmetic_v<T2> && std::is_same_v<divide_t<T1, T2>, T1> && simd::use_kernel_v<T1, N>) {
+                    if !consteval {
+                        simd::binary<simd::op::div>(a.data(), static_cast<T1>(b), result.data(), N);
+                        return result;
+                    }
+                }
+
+                for (size_t i = 0; i < N; ++i)
+                    result[i] = div(a[i], b);
+                return result;
+
+            }
+
+        };
+
+        template <typename T1, typename T2, size_t N>
+            requires (is_scalar_v<T1>)
+        struct divide_impl<T1, std::array<T2, N>> {
+
+            using result_t = std::array<divide_t<T1, T2>, N>;
+
+            static constexpr result_t f(const T1& a, const std::array<T2, N>& b) noexcept {
+
+                result_t result{};
+
+                if constexpr (std::is_arithmetic_v<T1> && std::is_same_v<divide_t<T1, T2>, T2> && simd::use_kernel_v<T2, N>) {
+                    if !consteval {
+                        simd::binary<simd::op::div>(static_cast<T2>(a), b.data(), result.data(), N);
+                        return result;
+                    }
+                }
+
+                for (size_t i = 0; i < N; ++i)
+                    result[i] = div(a, b[i]);
+                return result;
+
+            }
+
+        };
+
+
+        /// @brief Divide specialization for vectors, expressions and scalars, evaluated lazily
+        template <typename T1, typename T2>
+            requires ((are_expression_operand_v<T1, T2>) ||
+                      (is_expression_operand_v<T1> && is_scalar_v<T2>) ||
+                      (is_scalar_v<T1> && is_expression_operand_v<T2>))
+        struct divide_impl<T1, T2> {
+
+            using result_t = expression<divide_op, T1, T2>;
+
+            static constexpr result_t f(const T1& a, const T2& b) {
+                return {a, b};
+            }
+
+        };
+
+
+        /// @brief Divide specialization for quantities
+        template <typename T1, typename T2>
+            requires (are_quantity_v<T1, T2>)
+        struct divide_impl<T1, T2> {
+
+            using result_t = quantity<divide_t<typename T1::value_t, typename T2::value_t>,
+                                      divide_t<typename T1::unit_t, typename T2::unit_t>>;
+
+            static constexpr result_t f(const T1& x, const T2& y) {
+                return div(x.value, y.value);
+            }
+
+        };
+
+
+        /// @brief Divide specialization for quantities and numbers
+        template <typename T1, typename T2>
+            requires (is_quantity_v<T1> && is_scalar_v<T2>)
+        struct divide_impl<T1, T2> {
+
+            using result_t = quantity<divide_t<typename T1::value_t, T2>, typename T1::unit_t>;
+
+            static constexpr result_t f(const T1& x, const T2& y) {
+                return div(x.value, y);
+            }
+
+        };
+
+        template <typename T1, typename T2>
+            requires (is_scalar_v<T1> && is_quantity_v<T2>)
+        struct divide_impl<T1, T2> {
+
+            using result_t = quantity<divide_t<T1, typename T2::value_t>, invert_t<typename T2::unit_t>>;
+
+            static constexpr result_t f(const T1& x, const T2& y) {
+                return div(x, y.value);
+            }
+
+        };
+
+
+        /// @brief Divide specialization for measurements
+        template <typename T1, typename T2>
+        struct divide_impl<measurement<T1>, measurement<T2>> {
+
+            using result_t = measurement<quantity<eval_t<divide_t<typename T1::value_t, typename T2::value_t>>,
+                                                  divide_t<typename T1::unit_t, typename T2::unit_t>>>;
+
+            static constexpr result_t f(const measurement<T1>& x, const measurement<T2>& y) {
+
+                return { div(x.val, y.val), sqrt(add(sq(div(x.unc, y.val)), sq(div(mult(x.val, y.unc), sq(y.val))))) };
+
+            }
+
+        };
+
+
+        /// @brief Divide-assign specialization for arrays, computed in place
+        template <typename T1, typename T2, size_t N>
+        struct divide_assign_impl<std::array<T1, N>, std::array<T2, N>> {
+
+            static constexpr void f(std::array<T1, N>& x, const std::array<T2, N>& y) noexcept {
+
+                if constexpr (std::is_same_v<T1, T2> && simd::use_kernel_v<T1, N>) {
+                    if !consteval {
+                        simd::binary<simd::op::div>(x.data(), y.data(), x.data(), N);
+                        return;
+                    }
+                }
+
+                for (size_t i = 0; i < N; ++i)
+                    div_assign(x[i], y[i]);
+
+            }
+
+        };
+
+
+        /// @brief Divide-assign specialization for arrays and numbers, computed in place
+        template <typename T1, size_t N, typename T2>
+            requires (is_scalar_v<T2>)
+        struct divide_assign_impl<std::array<T1, N>, T2> {
+
+            static constexpr void f(std::array<T1, N>& x, const T2& y) noexcept {
+
+                if constexpr (std::is_arithmetic_v<T2> && std::is_same_v<divide_t<T1, T2>, T1> && simd::use_kernel_v<T1, N>) {
+                    if !consteval {
+                        simd::binary<simd::op::div>(x.data(), static_cast<T1>(y), x.data(), N);
+                        return;
+                    }
+                }
+
+                for (size_t i = 0; i < N; ++i)
+                    div_assign(x[i], y);
+
+            }
+
+        };
+
+
+        /// @brief Divide-assign specialization for vectors and spans, evaluated in place in a single pass
+        /// @note  The evaluation is element-wise, so y can be an expression referring to x.
+        template <typename T1, typename T2>
+            requires (is_expression_operand_v<T1> && !is_expression_v<T1> && is_expression_v<divide_t<T1, T2>>)
+        struct divide_assign_impl<T1, T2> {
+
+            static constexpr void f(T1& x, const T2& y) {
+                div(x, y).eval_into(x);
+            }
+
+        };
+
+
+        /// @brief Divide-assign specialization for quantities and numbers, computed in place
+        template <typename T1, typename T2>
+            requires (is_quantity_v<T1> && is_scalar_v<T2>)
+        struct divide_assign_impl<T1, T2> {
+
+            static constexpr void f(T1& x, const T2& y) {
+                div_assign(x.value, y);
+            }
+
+        };
+
+
+    } // namespace math
+
+
+} // namespace ctda
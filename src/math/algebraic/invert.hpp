@@ -21,13 +21,7 @@ namespace ctda {
             requires (is_base_v<T>)
         struct invert_impl<T> {
 
-            using result_t = base_quantity<-T::powers[0],
-                                           -T::powers[1],
-                                           -T::powers[2],
-                                           -T::powers[3],
-                                           -T::powers[4],
-                                           -T::powers[5],
-                                           -T::powers[6]>;
+            using result_t = packed_base<(dimension{} / dimension{T::packed}).bits>;
 
             static constexpr result_t f(const T&) noexcept {
                 return {};
@@ -55,8 +49,8 @@ namespace ctda {
             requires (is_unit_v<T>)
         struct invert_impl<T> { 
             
-            using result_t = unit<invert_t<typename T::base_t>, 
-                                  invert_t<typename T::prefix_t>>;
+            using result_t = unit<packed_base<(dimension{} / dimension{T::base_t::packed}).bits>, 
+                                  std::ratio<T::prefix_t::den, T::prefix_t::num>>;
 
             static constexpr result_t f(const T&) noexcept {
                 return {};
@@ -79,6 +73,35 @@ namespace ctda {
         };
 
 
+        /// @brief Invert specialization for dual numbers
+        template <typename T, size_t N>
+        struct invert_impl<dual<T, N>> {
+
+            using result_t = dual<T, N>;
+
+            static constexpr result_t f(const dual<T, N>& x) noexcept {
+
+                const T r = T(1) / x.val;
+                return {r, x.d * (-r * r)};
+
+            }
+
+        };
+
+
+        /// @brief Invert specialization for dynamic quantities
+        template <typename T>
+        struct invert_impl<dynamic_quantity<T>> {
+
+            using result_t = dynamic_quantity<invert_t<T>>;
+
+            static constexpr result_t f(const dynamic_quantity<T>& x) {
+                return {inv(x.value), x.unit.pow(-1)};
+            }
+
+        };
+
+
         /// @brief Invert specialization for std::array
         template <typename T, size_t N>
         struct invert_impl<std::array<T, N>> {
@@ -88,6 +111,14 @@ namespace ctda {
             static constexpr result_t f(const std::array<T, N>& arr) noexcept {
 
                 result_t result{};
+
+                if constexpr (std::is_same_v<T, invert_t<T>> && simd::use_kernel_v<T, N>) {
+                    if !consteval {
+                        simd::unary<simd::op::inv>(arr.data(), result.data(), N);
+                        return result;
+                    }
+                }
+
                 for (size_t i = 0; i < N; ++i) 
                     result[i] = inv(arr[i]);
                 return result;
@@ -97,6 +128,20 @@ namespace ctda {
         };
 
 
+        /// @brief Invert specialization for vectors and expressions, evaluated lazily
+        template <typename T>
+            requires (is_expression_operand_v<T>)
+        struct invert_impl<T> {
+
+            using result_t = expression<invert_op, T>;
+
+            static constexpr result_t f(const T& x) noexcept {
+                return {x};
+            }                                             
+
+        };
+
+
         /// @brief Invert specialization for quantities
         template <typename T>
             requires (is_quantity_v<T>)
@@ -112,6 +157,21 @@ namespace ctda {
         };
 
 
+        /// @brief Invert specialization for measurements
+        template <typename T>
+        struct invert_impl<measurement<T>> {
+
+            using result_t = measurement<quantity<eval_t<invert_t<typename T::value_t>>, invert_t<typename T::unit_t>>>;
+
+            static constexpr result_t f(const measurement<T>& x) {
+
+                return { inv(x.val), mult(x.unc, inv(sq(x.val))) };
+
+            }
+
+        };
+
+
     } // namespace math
 
 
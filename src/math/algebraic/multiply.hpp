@@ -21,13 +21,7 @@ namespace ctda {
             requires (are_base_v<T1, T2>)
         struct multiply_impl<T1, T2> {
 
-            using result_t = base_quantity<T1::powers[0] + T2::powers[0],
-                                           T1::powers[1] + T2::powers[1],
-                                           T1::powers[2] + T2::powers[2],
-                                           T1::powers[3] + T2::powers[3],
-                                           T1::powers[4] + T2::powers[4],
-                                           T1::powers[5] + T2::powers[5],
-                                           T1::powers[6] + T2::powers[6]>;
+            using result_t = packed_base<(dimension{T1::packed} * dimension{T2::packed}).bits>;
 
             static constexpr result_t f(const T1&, const T2&) noexcept {
                 return {};
@@ -42,7 +36,7 @@ namespace ctda {
             requires (are_prefix_v<T1, T2>)
         struct multiply_impl<T1, T2> {
             
-            using result_t = std::ratio_multiply<T1, T2>;
+            using result_t = rational_t<rational{T1::num, T1::den} * rational{T2::num, T2::den}>;
 
             static constexpr result_t f(const T1&, const T2&) noexcept {
                 return {};
@@ -56,7 +50,7 @@ namespace ctda {
         requires (is_prefix_v<T1> && is_unit_v<T2>)
         struct multiply_impl<T1, T2> {
             
-            using result_t = unit<typename T2::base_t, multiply_t<T1, typename T2::prefix_t>>;
+            using result_t = unit<typename T2::base_t, rational_t<rational{T1::num, T1::den} * rational{T2::prefix_t::num, T2::prefix_t::den}>>;
 
             static constexpr result_t f(const T1&, const T2&) noexcept {
                 return {};
@@ -66,12 +60,14 @@ namespace ctda {
         
 
         /// @brief Multiply specialization for units
+        /// @note  The base and the prefix are computed in place, not dispatched again to their specializations,
+        ///        so a product of units instantiates only the unit of its result.
         template <typename T1, typename T2>
             requires (are_unit_v<T1, T2>)
         struct multiply_impl<T1, T2> { 
             
-            using result_t = unit<multiply_t<typename T1::base_t, typename T2::base_t>, 
-                                  multiply_t<typename T1::prefix_t, typename T2::prefix_t>>;
+            using result_t = unit<packed_base<(dimension{T1::base_t::packed} * dimension{T2::base_t::packed}).bits>, 
+                                  rational_t<rational{T1::prefix_t::num, T1::prefix_t::den} * rational{T2::prefix_t::num, T2::prefix_t::den}>>;
 
             static constexpr result_t f(const T1&, const T2&) noexcept {
                 return {};
@@ -108,6 +104,162 @@ namespace ctda {
         }; 
         
 
+        /// @brief Multiply specialization for dual numbers, the product rule applied to all the tangents at once
+        template <typename T, size_t N>
+        struct multiply_impl<dual<T, N>, dual<T, N>> {
+
+            using result_t = dual<T, N>;
+
+            static constexpr result_t f(const dual<T, N>& a, const dual<T, N>& b) noexcept {
+                return {a.val * b.val, a.d * b.val + b.d * a.val};
+            }
+
+        };
+
+        /// @brief Multiply specialization for dual numbers and numbers
+        template <typename T, size_t N, typename T2>
+            requires (std::is_arithmetic_v<T2>)
+        struct multiply_impl<dual<T, N>, T2> {
+
+            using result_t = dual<T, N>;
+
+            static constexpr result_t f(const dual<T, N>& a, const T2& b) noexcept {
+                return {a.val * static_cast<T>(b), a.d * static_cast<T>(b)};
+            }
+
+        };
+
+        template <typename T1, typename T, size_t N>
+            requires (std::is_arithmetic_v<T1>)
+        struct multiply_impl<T1, dual<T, N>> {
+
+            using result_t = dual<T, N>;
+
+            static constexpr result_t f(const T1& a, const dual<T, N>& b) noexcept {
+                return {static_cast<T>(a) * b.val, static_cast<T>(a) * b.d};
+            }
+
+        };
+
+
+        /// @brief Multiply specialization for complex vectors, with the SIMD kernel of the split planes
+        template <typename T, typename ALLOC_T>
+        struct multiply_impl<complex_vector<T, ALLOC_T>, complex_vector<T, ALLOC_T>> {
+
+            using result_t = complex_vector<T, ALLOC_T>;
+
+            static result_t f(const complex_vector<T, ALLOC_T>& a, const complex_vector<T, ALLOC_T>& b) {
+
+                if (a.size() != b.size())
+                    throw std::runtime_error("Cannot multiply vectors of different sizes");
+
+                result_t result(a.size(), memory::rebind_allocator<T>(a.get_allocator()));
+                simd::complex_mult(a.re.data(), a.im.data(), b.re.data(), b.im.data(), result.re.data(), result.im.data(), a.size());
+                return result;
+
+            }
+
+        };
+
+        /// @brief Multiply specialization for complex vectors and numbers or complex numbers, broadcasted to all the elements
+        template <typename T, typename ALLOC_T, typename T2>
+            requires (std::is_arithmetic_v<T2> || is_complex_v<T2>)
+        struct multiply_impl<complex_vector<T, ALLOC_T>, T2> {
+
+            using result_t = complex_vector<T, ALLOC_T>;
+
+            static result_t f(const complex_vector<T, ALLOC_T>& a, const T2& b) {
+
+                result_t result(a.size(), memory::rebind_allocator<T>(a.get_allocator()));
+                if constexpr (is_complex_v<T2>)
+                    simd::complex_mult(a.re.data(), a.im.data(), static_cast<T>(b.real()), static_cast<T>(b.imag()), result.re.data(), result.im.data(), a.size());
+                else {
+                    simd::binary<simd::op::mult>(a.re.data(), static_cast<T>(b), result.re.data(), a.size());
+                    simd::binary<simd::op::mult>(a.im.data(), static_cast<T>(b), result.im.data(), a.size());
+                }
+                return result;
+
+            }
+
+        };
+
+        template <typename T1, typename T, typename ALLOC_T>
+            requires (std::is_arithmetic_v<T1> || is_complex_v<T1>)
+        struct multiply_impl<T1, complex_vector<T, ALLOC_T>> {
+
+            using result_t = complex_vector<T, ALLOC_T>;
+
+            static result_t f(const T1& a, const complex_vector<T, ALLOC_T>& b) {
+                return mult(b, a);
+            }
+
+        };
+
+
+        /// @brief Multiply specialization for dynamic quantities: the packed powers of the units are added at once
+        template <typename T1, typename T2>
+        struct multiply_impl<dynamic_quantity<T1>, dynamic_quantity<T2>> {
+
+            using result_t = dynamic_quantity<std::common_type_t<T1, T2>>;
+
+            static constexpr result_t f(const dynamic_quantity<T1>& a, const dynamic_quantity<T2>& b) {
+                return {a.value * b.value, a.unit * b.unit};
+            }
+
+        };
+
+        /// @brief Multiply specialization for dynamic quantities and numbers
+        template <typename T1, typename T2>
+            requires (std::is_arithmetic_v<T2>)
+        struct multiply_impl<dynamic_quantity<T1>, T2> {
+
+            using result_t = dynamic_quantity<std::common_type_t<T1, T2>>;
+
+            static constexpr result_t f(const dynamic_quantity<T1>& a, const T2& b) noexcept {
+                return {a.value * b, a.unit};
+            }
+
+        };
+
+        template <typename T1, typename T2>
+            requires (std::is_arithmetic_v<T1>)
+        struct multiply_impl<T1, dynamic_quantity<T2>> {
+
+            using result_t = dynamic_quantity<std::common_type_t<T1, T2>>;
+
+            static constexpr result_t f(const T1& a, const dynamic_quantity<T2>& b) noexcept {
+                return {a * b.value, b.unit};
+            }
+
+        };
+
+
+        /// @brief Multiply specialization for arrays
+        template <typename T1, typename T2, size_t N>
+        struct multiply_impl<std::array<T1, N>, std::array<T2, N>> {
+
+            using result_t = std::array<multiply_t<T1, T2>, N>;
+
+            static constexpr result_t f(const std::array<T1, N>& a, const std::array<T2, N>& b) noexcept {
+                
+                result_t result{};
+
+                if constexpr (std::is_same_v<T1, T2> && simd::use_kernel_v<T1, N>) {
+                    if !consteval {
+                        simd::binary<simd::op::mult>(a.data(), b.data(), result.data(), N);
+                        return result;
+                    }
+                }
+
+                for (size_t i = 0; i < N; ++i) 
+                    result[i] = mult(a[i], b[i]);
+                return result;
+
+            }                                             
+
+        };
+
+
         /// @brief Multiply specialization for numbers and arrays
         template <typename T1, typename T2, size_t N>
             requires (std::is_arithmetic_v<T1> || is_complex_v<T1>)
@@ -118,6 +270,14 @@ namespace ctda {
             static constexpr result_t f(const T1& a, const std::array<T2, N>& b) noexcept {
                 
                 result_t result{};
+
+                if constexpr (std::is_arithmetic_v<T1> && std::is_same_v<multiply_t<T1, T2>, T2> && simd::use_kernel_v<T2, N>) {
+                    if !consteval {
+                        simd::binary<simd::op::mult>(static_cast<T2>(a), b.data(), result.data(), N);
+                        return result;
+                    }
+                }
+
                 for (size_t i = 0; i < N; ++i) 
                     result[i] = a * b[i];
                 return result;
@@ -135,6 +295,14 @@ namespace ctda {
             static constexpr result_t f(const std::array<T1, N>& a, const T2& b) noexcept {
                 
                 result_t result{};
+
+                if constexpr (std::is_arithmetic_v<T2> && std::is_same_v<multiply_t<T1, T2>, T1> && simd::use_kernel_v<T1, N>) {
+                    if !consteval {
+                        simd::binary<simd::op::mult>(a.data(), static_cast<T1>(b), result.data(), N);
+                        return result;
+                    }
+                }
+
                 for (size_t i = 0; i < N; ++i) 
                     result[i] = a[i] * b;
                 return result;
@@ -144,6 +312,22 @@ namespace ctda {
         };
 
 
+        /// @brief Multiply specialization for vectors, expressions and scalars, evaluated lazily
+        template <typename T1, typename T2>
+            requires ((are_expression_operand_v<T1, T2>) || 
+                      (is_expression_operand_v<T1> && is_scalar_v<T2>) || 
+                      (is_scalar_v<T1> && is_expression_operand_v<T2>))
+        struct multiply_impl<T1, T2> {
+
+            using result_t = expression<multiply_op, T1, T2>;
+
+            static constexpr result_t f(const T1& a, const T2& b) {
+                return {a, b};
+            }                                             
+
+        };
+
+
         /// @brief Multiply specialization for quantities
         template <typename T1, typename T2>
             requires (are_quantity_v<T1, T2>)
@@ -152,7 +336,7 @@ namespace ctda {
             using result_t = quantity<multiply_t<typename T1::value_t, typename T2::value_t>, 
                                       multiply_t<typename T1::unit_t, typename T2::unit_t>>;
 
-            static constexpr result_t f(const T1& x, const T2& y) noexcept {
+            static constexpr result_t f(const T1& x, const T2& y) {
                 return x.value * y.value;
             }
 
@@ -166,7 +350,7 @@ namespace ctda {
 
             using result_t = quantity<multiply_t<typename T1::value_t, T2>, typename T1::unit_t>;
 
-            static constexpr result_t f(const T1& x, const T2& y) noexcept {
+            static constexpr result_t f(const T1& x, const T2& y) {
                 return x.value * y;
             }
             
@@ -178,7 +362,7 @@ namespace ctda {
 
             using result_t = quantity<multiply_t<T1, typename T2::value_t>, typename T2::unit_t>;
 
-            static constexpr result_t f(const T1& x, const T2& y) noexcept {
+            static constexpr result_t f(const T1& x, const T2& y) {
                 return x * y.value;
             }
             
@@ -192,9 +376,20 @@ namespace ctda {
 
             using result_t = quantity<std::array<multiply_t<typename T1::value_t, T2>, N>, typename T1::unit_t>;
 
+            /// whether the product runs on the kernels, the value of the quantity broadcasted
+            static constexpr bool vectorizable = std::is_same_v<multiply_t<typename T1::value_t, T2>, T2> && simd::use_kernel_v<T2, N>;
+
             static constexpr result_t f(const T1& a, const std::array<T2, N>& b) noexcept {
                 
                 result_t result{};
+
+                if constexpr (vectorizable) {
+                    if !consteval {
+                        simd::binary<simd::op::mult>(static_cast<T2>(a.value), b.data(), result.value.data(), N);
+                        return result;
+                    }
+                }
+
                 for (size_t i = 0; i < N; ++i) 
                     result.value[i] = a.value * b[i];
                 return result;
@@ -209,9 +404,20 @@ namespace ctda {
 
             using result_t = quantity<std::array<multiply_t<T1, typename T2::value_t>, N>, typename T2::unit_t>;
 
+            /// whether the product runs on the kernels, the value of the quantity broadcasted
+            static constexpr bool vectorizable = std::is_same_v<multiply_t<T1, typename T2::value_t>, T1> && simd::use_kernel_v<T1, N>;
+
             static constexpr result_t f(const std::array<T1, N>& a, const T2& b) noexcept {
                 
                 result_t result{};
+
+                if constexpr (vectorizable) {
+                    if !consteval {
+                        simd::binary<simd::op::mult>(a.data(), static_cast<T1>(b.value), result.value.data(), N);
+                        return result;
+                    }
+                }
+
                 for (size_t i = 0; i < N; ++i) 
                     result.value[i] = a[i] * b.value;
                 return result;
@@ -221,6 +427,90 @@ namespace ctda {
         };        
 
 
+        /// @brief Multiply specialization for measurements
+        template <typename T1, typename T2>
+        struct multiply_impl<measurement<T1>, measurement<T2>> {
+
+            using result_t = measurement<quantity<eval_t<multiply_t<typename T1::value_t, typename T2::value_t>>, 
+                                                  multiply_t<typename T1::unit_t, typename T2::unit_t>>>;
+
+            static constexpr result_t f(const measurement<T1>& x, const measurement<T2>& y) {
+                
+                return { mult(x.val, y.val), sqrt(add(sq(mult(y.val, x.unc)), sq(mult(x.val, y.unc)))) };
+
+            }
+
+        };
+
+
+        /// @brief Multiply-assign specialization for arrays, computed in place
+        template <typename T1, typename T2, size_t N>
+        struct multiply_assign_impl<std::array<T1, N>, std::array<T2, N>> {
+
+            static constexpr void f(std::array<T1, N>& x, const std::array<T2, N>& y) noexcept {
+
+                if constexpr (std::is_same_v<T1, T2> && simd::use_kernel_v<T1, N>) {
+                    if !consteval {
+                        simd::binary<simd::op::mult>(x.data(), y.data(), x.data(), N);
+                        return;
+                    }
+                }
+
+                for (size_t i = 0; i < N; ++i)
+                    mult_assign(x[i], y[i]);
+
+            }
+
+        };
+
+
+        /// @brief Multiply-assign specialization for arrays and numbers, computed in place
+        template <typename T1, size_t N, typename T2>
+            requires (is_scalar_v<T2>)
+        struct multiply_assign_impl<std::array<T1, N>, T2> {
+
+            static constexpr void f(std::array<T1, N>& x, const T2& y) noexcept {
+
+                if constexpr (std::is_arithmetic_v<T2> && std::is_same_v<multiply_t<T1, T2>, T1> && simd::use_kernel_v<T1, N>) {
+                    if !consteval {
+                        simd::binary<simd::op::mult>(x.data(), static_cast<T1>(y), x.data(), N);
+                        return;
+                    }
+                }
+
+                for (size_t i = 0; i < N; ++i)
+                    mult_assign(x[i], y);
+
+            }
+
+        };
+
+
+        /// @brief Multiply-assign specialization for vectors and spans, evaluated in place in a single pass
+        /// @note  The evaluation is element-wise, so y can be an expression referring to x.
+        template <typename T1, typename T2>
+            requires (is_expression_operand_v<T1> && !is_expression_v<T1> && is_expression_v<multiply_t<T1, T2>>)
+        struct multiply_assign_impl<T1, T2> {
+
+            static constexpr void f(T1& x, const T2& y) {
+                mult(x, y).eval_into(x);
+            }
+
+        };
+
+
+        /// @brief Multiply-assign specialization for quantities and numbers, computed in place
+        template <typename T1, typename T2>
+            requires (is_quantity_v<T1> && is_scalar_v<T2>)
+        struct multiply_assign_impl<T1, T2> {
+
+            static constexpr void f(T1& x, const T2& y) {
+                mult_assign(x.value, y);
+            }
+
+        };
+
+
     } // namespace math
 
 
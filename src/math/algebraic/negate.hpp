@@ -30,6 +30,50 @@ namespace ctda {
         };
 
 
+        /// @brief Negate specialization for dual numbers
+        template <typename T, size_t N>
+        struct negate_impl<dual<T, N>> {
+
+            using result_t = dual<T, N>;
+
+            static constexpr result_t f(const dual<T, N>& x) noexcept {
+                return {-x.val, -x.d};
+            }
+
+        };
+
+
+        /// @brief Negate specialization for complex vectors, computed plane by plane
+        template <typename T, typename ALLOC_T>
+        struct negate_impl<complex_vector<T, ALLOC_T>> {
+
+            using result_t = complex_vector<T, ALLOC_T>;
+
+            static result_t f(const complex_vector<T, ALLOC_T>& x) {
+
+                result_t result(x.size(), memory::rebind_allocator<T>(x.get_allocator()));
+                simd::unary<simd::op::neg>(x.re.data(), result.re.data(), x.size());
+                simd::unary<simd::op::neg>(x.im.data(), result.im.data(), x.size());
+                return result;
+
+            }
+
+        };
+
+
+        /// @brief Negate specialization for dynamic quantities
+        template <typename T>
+        struct negate_impl<dynamic_quantity<T>> {
+
+            using result_t = dynamic_quantity<T>;
+
+            static constexpr result_t f(const dynamic_quantity<T>& x) noexcept {
+                return {-x.value, x.unit};
+            }
+
+        };
+
+
         /// @brief Negate specialization for std::array
         template <typename T, size_t N>
         struct negate_impl<std::array<T, N>> {
@@ -39,6 +83,14 @@ namespace ctda {
             static constexpr result_t f(const std::array<T, N>& arr) noexcept {
 
                 result_t result{};
+
+                if constexpr (simd::use_kernel_v<T, N>) {
+                    if !consteval {
+                        simd::unary<simd::op::neg>(arr.data(), result.data(), N);
+                        return result;
+                    }
+                }
+
                 for (size_t i = 0; i < N; ++i) 
                     result[i] = neg(arr[i]);
                 return result;
@@ -48,12 +100,26 @@ namespace ctda {
         };
 
 
+        /// @brief Negate specialization for vectors and expressions, evaluated lazily
+        template <typename T>
+            requires (is_expression_operand_v<T>)
+        struct negate_impl<T> {
+
+            using result_t = expression<negate_op, T>;
+
+            static constexpr result_t f(const T& x) noexcept {
+                return {x};
+            }                                             
+
+        };
+
+
         /// @brief Negate specialization for quantities
         template <typename T>
             requires (is_quantity_v<T>)
         struct negate_impl<T> {
 
-            using result_t = T;
+            using result_t = quantity<negate_t<typename T::value_t>, typename T::unit_t>;
 
             static constexpr result_t f(const T& x) noexcept {
                 return neg(x.value);
@@ -62,6 +128,19 @@ namespace ctda {
         };
 
 
+        /// @brief Negate specialization for measurements
+        template <typename T>
+        struct negate_impl<measurement<T>> {
+
+            using result_t = measurement<quantity<eval_t<negate_t<typename T::value_t>>, typename T::unit_t>>;
+
+            static constexpr result_t f(const measurement<T>& x) {
+                return { neg(x.val), x.unc };
+            }
+
+        };
+
+
     } // namespace math
 
 
@@ -21,13 +21,7 @@ namespace ctda {
             requires (is_base_v<BASE_T>)
         struct power_impl<POWER, BASE_T> {
 
-            using result_t = base_quantity<BASE_T::powers[0] * POWER, 
-                                           BASE_T::powers[1] * POWER,
-                                           BASE_T::powers[2] * POWER,
-                                           BASE_T::powers[3] * POWER,
-                                           BASE_T::powers[4] * POWER,
-                                           BASE_T::powers[5] * POWER,
-                                           BASE_T::powers[6] * POWER>;
+            using result_t = packed_base<dimension{BASE_T::packed}.pow(POWER).bits>;
 
             inline static constexpr result_t f(const BASE_T&) noexcept {
 
@@ -39,12 +33,12 @@ namespace ctda {
 
 
         /// @brief Return the power of a prefix
+        /// @note  It is computed with exact integer arithmetic: a power which does not fit a 'std::ratio' is a compile error.
         template <int POWER, typename PREFIX_T>
             requires (is_prefix_v<PREFIX_T>)
         struct power_impl<POWER, PREFIX_T> {
             
-            using result_t = std::ratio<static_cast<size_t>(std::pow(PREFIX_T::num, POWER)), 
-                                        static_cast<size_t>(std::pow(PREFIX_T::den, POWER))>;
+            using result_t = rational_t<rational{PREFIX_T::num, PREFIX_T::den}.pow(POWER)>;
 
             inline static constexpr result_t f(const PREFIX_T&) noexcept {
 
@@ -60,8 +54,8 @@ namespace ctda {
             requires (is_unit_v<UNIT_T>)
         struct power_impl<POWER, UNIT_T> {
             
-            using result_t = unit<power_t<POWER, typename UNIT_T::base_t>, 
-                                  power_t<POWER, typename UNIT_T::prefix_t>>;
+            using result_t = unit<packed_base<dimension{UNIT_T::base_t::packed}.pow(POWER).bits>, 
+                                  rational_t<rational{UNIT_T::prefix_t::num, UNIT_T::prefix_t::den}.pow(POWER)>>;
 
             inline static constexpr result_t f(const UNIT_T&) noexcept {
 
@@ -72,7 +66,7 @@ namespace ctda {
         };
 
 
-        /// @brief Return the power of a number
+        /// @brief Return the power of a number, by squaring instead of a call to 'std::pow'
         template <int POWER, typename T>
             requires (std::is_arithmetic_v<T>)
         struct power_impl<POWER, T> {
@@ -81,13 +75,49 @@ namespace ctda {
 
             inline static constexpr result_t f(const T& x) noexcept {
 
-                return std::pow(x, POWER);
+                T result = x;
+                simd::raise<POWER>(result);
+                return result;
 
             }       
 
         };
 
 
+        /// @brief Return the power of a dual number
+        template <int POWER, typename T, size_t N>
+        struct power_impl<POWER, dual<T, N>> {
+
+            using result_t = dual<T, N>;
+
+            static constexpr result_t f(const dual<T, N>& x) noexcept {
+
+                if constexpr (POWER == 0)
+                    return T(1);
+                else {
+                    const T p = pow<POWER - 1>(x.val);
+                    return {p * x.val, x.d * (POWER * p)};
+                }
+
+            }
+
+        };
+
+
+        /// @brief Return the power of a dynamic quantity
+        /// @throw 'std::overflow_error' if a power of the unit is out of the range of its packed byte or its prefix overflows.
+        template <int POWER, typename T>
+        struct power_impl<POWER, dynamic_quantity<T>> {
+
+            using result_t = dynamic_quantity<power_t<POWER, T>>;
+
+            static constexpr result_t f(const dynamic_quantity<T>& x) {
+                return {pow<POWER>(x.value), x.unit.pow(POWER)};
+            }
+
+        };
+
+
         /// @brief Return the power of an array
         template <int POWER, typename T, size_t N>
         struct power_impl<POWER, std::array<T, N>> {
@@ -97,6 +127,14 @@ namespace ctda {
             static constexpr result_t f(const std::array<T, N>& x) noexcept {
 
                 result_t result{};
+
+                if constexpr (simd::use_kernel_v<T, N>) {
+                    if !consteval {
+                        simd::unary<simd::op::pow, POWER>(x.data(), result.data(), N);
+                        return result;
+                    }
+                }
+
                 for (size_t i = 0; i < N; ++i) 
                     result[i] = pow<POWER>(x[i]);
                 return result;
@@ -106,15 +144,16 @@ namespace ctda {
         };
 
 
-        /// @brief Return the power of a vector
-        template <int POWER, typename T>
-        struct power_impl<POWER, std::vector<T>> {
+        /// @brief Return the power of a vector of non scalar types
+        template <int POWER, typename T, typename ALLOC_T>
+            requires (!is_expression_operand_v<std::vector<T, ALLOC_T>>)
+        struct power_impl<POWER, std::vector<T, ALLOC_T>> {
             
-            using result_t = std::vector<power_t<POWER, T>>;
+            using result_t = std::vector<power_t<POWER, T>, memory::rebind_alloc_t<ALLOC_T, power_t<POWER, T>>>;
 
-            static constexpr result_t f(const std::vector<T>& x) noexcept {
+            static constexpr result_t f(const std::vector<T, ALLOC_T>& x) {
 
-                result_t result(x.size());
+                result_t result(x.size(), memory::rebind_allocator<power_t<POWER, T>>(x.get_allocator()));
                 for (size_t i = 0; i < x.size(); ++i) 
                     result[i] = pow<POWER>(x[i]);
                 return result;
@@ -124,6 +163,22 @@ namespace ctda {
         };
 
 
+        /// @brief Return the power of a vector or an expression, evaluated lazily
+        template <int POWER, typename T>
+            requires (is_expression_operand_v<T>)
+        struct power_impl<POWER, T> {
+            
+            using result_t = expression<power_op<POWER>, T>;
+
+            inline static constexpr result_t f(const T& x) noexcept {
+
+                return {x};
+
+            }       
+
+        };
+
+
         /// @brief Return the power of a quantity
         template <int POWER, typename T>
             requires (is_quantity_v<T>)
@@ -17,18 +17,12 @@ namespace ctda {
 
 
 
-        /// @brief Return the power of a base_quantity
+        /// @brief Return the root of a base_quantity: its powers are divided exactly, so the root of a length has a power 1/2.
         template <int POWER, typename BASE_T>
             requires (is_base_v<BASE_T>)
         struct root_impl<POWER, BASE_T> {
 
-            using result_t = base_quantity<BASE_T::powers[0] / POWER, 
-                                           BASE_T::powers[1] / POWER,
-                                           BASE_T::powers[2] / POWER,
-                                           BASE_T::powers[3] / POWER,
-                                           BASE_T::powers[4] / POWER,
-                                           BASE_T::powers[5] / POWER,
-                                           BASE_T::powers[6] / POWER>;
+            using result_t = packed_base<dimension{BASE_T::packed}.root(POWER).bits>;
 
             inline static constexpr result_t f(const BASE_T&) noexcept {
 
@@ -39,13 +33,13 @@ namespace ctda {
         };
 
 
-        /// @brief Return the power of a prefix
+        /// @brief Return the root of a prefix
+        /// @note  The root is exact, and a prefix without a rational root, as a kilo for the square root, is a compile error.
         template <int POWER, typename PREFIX_T>
             requires (is_prefix_v<PREFIX_T>)
         struct root_impl<POWER, PREFIX_T> {
             
-            using result_t = std::ratio<static_cast<size_t>(std::pow(PREFIX_T::num, inv(POWER))), 
-                                        static_cast<size_t>(std::pow(PREFIX_T::den, inv(POWER)))>;
+            using result_t = rational_t<rational{PREFIX_T::num, PREFIX_T::den}.root(POWER)>;
 
             inline static constexpr result_t f(const PREFIX_T&) noexcept {
 
@@ -56,13 +50,13 @@ namespace ctda {
         };
 
 
-        /// @brief Return the power of an unit
+        /// @brief Return the root of an unit
         template <int POWER, typename UNIT_T>
             requires (is_unit_v<UNIT_T>)
         struct root_impl<POWER, UNIT_T> {
             
-            using result_t = unit<root_t<POWER, typename UNIT_T::base_t>, 
-                                  root_t<POWER, typename UNIT_T::prefix_t>>;
+            using result_t = unit<packed_base<dimension{UNIT_T::base_t::packed}.root(POWER).bits>, 
+                                  rational_t<rational{UNIT_T::prefix_t::num, UNIT_T::prefix_t::den}.root(POWER)>>;
 
             inline static constexpr result_t f(const UNIT_T&) noexcept {
 
@@ -73,7 +67,7 @@ namespace ctda {
         };
 
 
-        /// @brief Return the power of a number
+        /// @brief Return the root of a number, with square and cube roots instead of 'std::pow' where they apply
         template <int POWER, typename T>
             requires (std::is_arithmetic_v<T>)
         struct root_impl<POWER, T> {
@@ -82,14 +76,46 @@ namespace ctda {
 
             inline static constexpr result_t f(const T& x) noexcept {
 
-                return std::pow(x, inv(POWER));
+                std::conditional_t<std::is_integral_v<T>, double, T> result = x;
+                simd::extract<POWER>(result);
+                return static_cast<T>(result);
 
             }       
 
         };
 
 
-        /// @brief Return the power of an array
+        /// @brief Return the root of a dynamic quantity
+        /// @throw 'std::domain_error' if the prefix of the unit has no exact root.
+        template <int POWER, typename T>
+        struct root_impl<POWER, dynamic_quantity<T>> {
+
+            using result_t = dynamic_quantity<root_t<POWER, T>>;
+
+            static constexpr result_t f(const dynamic_quantity<T>& x) {
+                return {root<POWER>(x.value), x.unit.root(POWER)};
+            }
+
+        };
+
+
+        /// @brief Return the root of a dual number
+        template <int POWER, typename T, size_t N>
+        struct root_impl<POWER, dual<T, N>> {
+
+            using result_t = dual<T, N>;
+
+            static constexpr result_t f(const dual<T, N>& x) noexcept {
+
+                const T r = root<POWER>(x.val);
+                return {r, x.d * (r / (POWER * x.val))};
+
+            }
+
+        };
+
+
+        /// @brief Return the root of an array
         template <int POWER, typename T, size_t N>
         struct root_impl<POWER, std::array<T, N>> {
             
@@ -98,6 +124,14 @@ namespace ctda {
             static constexpr result_t f(const std::array<T, N>& x) noexcept {
 
                 result_t result{};
+
+                if constexpr (simd::has_root_kernel_v<POWER> && simd::use_kernel_v<T, N>) {
+                    if !consteval {
+                        simd::unary<simd::op::root, POWER>(x.data(), result.data(), N);
+                        return result;
+                    }
+                }
+
                 for (size_t i = 0; i < N; ++i) 
                     result[i] = root<POWER>(x[i]);
                 return result;
@@ -107,15 +141,16 @@ namespace ctda {
         };
 
 
-        /// @brief Return the power of a vector
-        template <int POWER, typename T>
-        struct root_impl<POWER, std::vector<T>> {
+        /// @brief Return the power of a vector of non scalar types
+        template <int POWER, typename T, typename ALLOC_T>
+            requires (!is_expression_operand_v<std::vector<T, ALLOC_T>>)
+        struct root_impl<POWER, std::vector<T, ALLOC_T>> {
             
-            using result_t = std::vector<root_t<POWER, T>>;
+            using result_t = std::vector<root_t<POWER, T>, memory::rebind_alloc_t<ALLOC_T, root_t<POWER, T>>>;
 
-            static constexpr result_t f(const std::vector<T>& x) noexcept {
+            static constexpr result_t f(const std::vector<T, ALLOC_T>& x) {
 
-                result_t result(x.size());
+                result_t result(x.size(), memory::rebind_allocator<root_t<POWER, T>>(x.get_allocator()));
                 for (size_t i = 0; i < x.size(); ++i) 
                     result[i] = root<POWER>(x[i]);
                 return result;
@@ -125,6 +160,22 @@ namespace ctda {
         };
 
 
+        /// @brief Return the root of a vector or an expression, evaluated lazily
+        template <int POWER, typename T>
+            requires (is_expression_operand_v<T>)
+        struct root_impl<POWER, T> {
+            
+            using result_t = expression<root_op<POWER>, T>;
+
+            inline static constexpr result_t f(const T& x) noexcept {
+
+                return {x};
+
+            }       
+
+        };
+
+
         /// @brief Return the power of a quantity
         template <int POWER, typename T>
             requires (is_quantity_v<T>)
@@ -0,0 +1,171 @@
+/**
+ * @file    math/algebraic/scale.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the implementation of the scale struct, used by the unit conversions.
+ * @date    2023-11-13
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#pragma once
+
+
+namespace ctda {
+
+
+    namespace math {
+
+
+        /// @brief Scale specialization for the unit ratio: the value is forwarded untouched
+        template <typename RATIO_T, typename T>
+            requires (std::ratio_equal_v<RATIO_T, std::ratio<1>>)
+        struct scale_impl<RATIO_T, T> {
+
+            using result_t = T;
+
+            static constexpr const result_t& f(const T& x) noexcept {
+                return x;
+            }
+
+        };
+
+
+        /// @brief Scale specialization for numbers
+        /// @note  An integer ratio costs a multiplication, the inverse of an integer a division,
+        ///        any other ratio a single multiplication by its value. Integers are truncated, 
+        ///        and scaled by quotient and remainder so that x * num does not overflow before the division:
+        ///        the result is exact as long as it fits, and num * den fits the type of the computation.
+        template <typename RATIO_T, typename T>
+            requires (!std::ratio_equal_v<RATIO_T, std::ratio<1>> && std::is_arithmetic_v<T>)
+        struct scale_impl<RATIO_T, T> {
+
+            using result_t = T;
+
+            static constexpr result_t f(const T& x) noexcept {
+
+                if constexpr (RATIO_T::den == 1)
+                    return x * static_cast<T>(RATIO_T::num);
+                else if constexpr (RATIO_T::num == 1)
+                    return x / static_cast<T>(RATIO_T::den);
+                else if constexpr (std::is_integral_v<T>)
+                    return static_cast<T>(x / RATIO_T::den * RATIO_T::num + x % RATIO_T::den * RATIO_T::num / RATIO_T::den);
+                else
+                    return x * static_cast<T>(static_cast<long double>(RATIO_T::num) / static_cast<long double>(RATIO_T::den));
+
+            }
+
+        };
+
+
+        /// @brief Scale specialization for complex numbers
+        template <typename RATIO_T, typename T>
+            requires (!std::ratio_equal_v<RATIO_T, std::ratio<1>>)
+        struct scale_impl<RATIO_T, std::complex<T>> {
+
+            using result_t = std::complex<T>;
+
+            static constexpr result_t f(const std::complex<T>& x) noexcept {
+                return {scale<RATIO_T>(x.real()), scale<RATIO_T>(x.imag())};
+            }
+
+        };
+
+
+        /// @brief Scale specialization for dual numbers
+        template <typename RATIO_T, typename T, size_t N>
+            requires (!std::ratio_equal_v<RATIO_T, std::ratio<1>>)
+        struct scale_impl<RATIO_T, dual<T, N>> {
+
+            using result_t = dual<T, N>;
+
+            static constexpr result_t f(const dual<T, N>& x) noexcept {
+                return {scale<RATIO_T>(x.val), x.d * scale<RATIO_T>(T(1))};
+            }
+
+        };
+
+
+        /// @brief Scale specialization for complex vectors, computed plane by plane
+        template <typename RATIO_T, typename T, typename ALLOC_T>
+            requires (!std::ratio_equal_v<RATIO_T, std::ratio<1>>)
+        struct scale_impl<RATIO_T, complex_vector<T, ALLOC_T>> {
+
+            using result_t = complex_vector<T, ALLOC_T>;
+
+            static result_t f(const complex_vector<T, ALLOC_T>& x) {
+
+                result_t result(x.size(), memory::rebind_allocator<T>(x.get_allocator()));
+                math::scale_op<RATIO_T>::block(result.re.data(), x.size(), x.re.data());
+                math::scale_op<RATIO_T>::block(result.im.data(), x.size(), x.im.data());
+                return result;
+
+            }
+
+        };
+
+
+        /// @brief Scale specialization for arrays
+        template <typename RATIO_T, typename T, size_t N>
+            requires (!std::ratio_equal_v<RATIO_T, std::ratio<1>>)
+        struct scale_impl<RATIO_T, std::array<T, N>> {
+
+            using result_t = std::array<scale_t<RATIO_T, T>, N>;
+
+            static constexpr result_t f(const std::array<T, N>& x) noexcept {
+
+                result_t result{};
+
+                if constexpr (simd::use_kernel_v<T, N>) {
+                    if !consteval {
+                        math::scale_op<RATIO_T>::block(result.data(), N, x.data());
+                        return result;
+                    }
+                }
+
+                for (size_t i = 0; i < N; ++i)
+                    result[i] = scale<RATIO_T>(x[i]);
+                return result;
+
+            }
+
+        };
+
+
+        /// @brief Scale specialization for vectors and expressions, evaluated lazily
+        template <typename RATIO_T, typename T>
+            requires (!std::ratio_equal_v<RATIO_T, std::ratio<1>> && is_expression_operand_v<T>)
+        struct scale_impl<RATIO_T, T> {
+
+            using result_t = expression<scale_op<RATIO_T>, T>;
+
+            static constexpr result_t f(const T& x) noexcept {
+                return {x};
+            }
+
+        };
+
+        /// @brief Scale specialization for scaled expressions: the chained ratios are folded at compile time
+        /// @note  When the ratios cancel out the operand is returned: by reference if it is a vector,
+        ///        which the expression references too, by value if the expression holds it, as an inner node,
+        ///        so that nothing refers to the storage of a temporary expression.
+        template <typename RATIO_T, typename INNER_RATIO_T, typename T>
+            requires (!std::ratio_equal_v<RATIO_T, std::ratio<1>>)
+        struct scale_impl<RATIO_T, expression<scale_op<INNER_RATIO_T>, T>> {
+
+            using ratio_t = std::ratio_multiply<INNER_RATIO_T, RATIO_T>;
+
+            using result_t = scale_t<ratio_t, T>;
+
+            using return_t = std::conditional_t<std::is_reference_v<expression_operand_t<T>>, decltype(scale<ratio_t>(std::declval<const T&>())), result_t>;
+
+            static constexpr return_t f(const expression<scale_op<INNER_RATIO_T>, T>& x) noexcept {
+                return scale<ratio_t>(std::get<0>(x.args));
+            }
+
+        };
+
+
+    } // namespace math
+
+
+} // namespace ctda
@@ -0,0 +1,232 @@
+/**
+ * @file    math/algebraic/subtract.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the implementation of the subtract struct.
+ * @date    2023-11-10
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#pragma once
+
+
+namespace ctda {
+
+
+    namespace math {
+
+
+        /// @brief Subtract specialization for numbers
+        template <typename T1, typename T2>
+            requires (std::is_arithmetic_v<T1> && std::is_arithmetic_v<T2>)
+        struct subtract_impl<T1, T2> {
+
+            using result_t = std::common_type_t<T1, T2>;
+
+            static constexpr result_t f(const T1& a, const T2& b) noexcept {
+                return a - b;
+            }
+
+        };
+
+
+        /// @brief Subtract specialization for complex numbers
+        template <typename T1, typename T2>
+        struct subtract_impl<std::complex<T1>, std::complex<T2>> {
+
+            using result_t = std::complex<std::common_type_t<T1, T2>>;
+
+            static constexpr result_t f(const std::complex<T1>& a, const std::complex<T2>& b) noexcept {
+                return {a.real() - b.real(), a.imag() - b.imag()};
+            }
+
+        };
+
+
+        /// @brief Subtract specialization for dual numbers
+        template <typename T, size_t N>
+        struct subtract_impl<dual<T, N>, dual<T, N>> {
+
+            using result_t = dual<T, N>;
+
+            static constexpr result_t f(const dual<T, N>& a, const dual<T, N>& b) noexcept {
+                return {a.val - b.val, a.d - b.d};
+            }
+
+        };
+
+
+        /// @brief Subtract specialization for complex vectors, computed plane by plane
+        template <typename T, typename ALLOC_T>
+        struct subtract_impl<complex_vector<T, ALLOC_T>, complex_vector<T, ALLOC_T>> {
+
+            using result_t = complex_vector<T, ALLOC_T>;
+
+            static result_t f(const complex_vector<T, ALLOC_T>& a, const complex_vector<T, ALLOC_T>& b) {
+
+                if (a.size() != b.size())
+                    throw std::runtime_error("Cannot subtract vectors of different sizes");
+
+                result_t result(a.size(), memory::rebind_allocator<T>(a.get_allocator()));
+                simd::binary<simd::op::sub>(a.re.data(), b.re.data(), result.re.data(), a.size());
+                simd::binary<simd::op::sub>(a.im.data(), b.im.data(), result.im.data(), a.size());
+                return result;
+
+            }
+
+        };
+
+
+        /// @brief Subtract specialization for array
+        template <typename T1, typename T2, size_t N>
+        struct subtract_impl<std::array<T1, N>, std::array<T2, N>> {
+
+            using result_t = std::array<subtract_t<T1, T2>, N>;
+
+            static constexpr result_t f(const std::array<T1, N>& a, const std::array<T2, N>& b) noexcept {
+
+                result_t result{};
+
+                if constexpr (std::is_same_v<T1, T2> && simd::use_kernel_v<T1, N>) {
+                    if !consteval {
+                        simd::binary<simd::op::sub>(a.data(), b.data(), result.data(), N);
+                        return result;
+                    }
+                }
+
+                for (size_t i = 0; i < N; ++i)
+                    result[i] = sub(a[i], b[i]);
+                return result;
+
+            }
+
+        };
+
+
+        /// @brief Subtract specialization for vectors and expressions, evaluated lazily
+        template <typename T1, typename T2>
+            requires (are_expression_operand_v<T1, T2>)
+        struct subtract_impl<T1, T2> {
+
+            using result_t = expression<subtract_op, T1, T2>;
+
+            static constexpr result_t f(const T1& a, const T2& b) {
+                return {a, b};
+            }
+
+        };
+
+
+        /// @brief Subtract specialization for quantities
+        template <typename T1, typename T2>
+            requires (are_same_quantity_v<T1, T2>)
+        struct subtract_impl<T1, T2> {
+
+            using result_t = quantity<subtract_t<typename T1::value_t, scale_t<conversion_t<typename T2::unit_t, typename T1::unit_t>, typename T2::value_t>>, 
+                                      typename T1::unit_t>;
+
+            static constexpr result_t f(const T1& x, const T2& y) {
+
+                if constexpr (std::is_same_v<typename T1::unit_t, typename T2::unit_t>)
+                    return sub(x.value, y.value);
+                else
+                    return sub(x.value, scale<conversion_t<typename T2::unit_t, typename T1::unit_t>>(y.value));
+
+            }
+
+        };
+
+
+        /// @brief Subtract specialization for dimensionless quantities and numbers
+        template <typename T1, typename T2>
+            requires (is_quantity_v<T1> && std::is_same_v<typename T1::base_t, dimensionless> && is_scalar_v<T2>)
+        struct subtract_impl<T1, T2> {
+
+            using result_t = quantity<subtract_t<typename T1::value_t, T2>, typename T1::unit_t>;
+
+            static constexpr result_t f(const T1& x, const T2& y) noexcept {
+                return sub(x.value, y);
+            }
+
+        };
+
+        template <typename T1, typename T2>
+            requires (is_scalar_v<T1> && is_quantity_v<T2> && std::is_same_v<typename T2::base_t, dimensionless>)
+        struct subtract_impl<T1, T2> {
+
+            using result_t = quantity<subtract_t<T1, typename T2::value_t>, typename T2::unit_t>;
+
+            static constexpr result_t f(const T1& x, const T2& y) noexcept {
+                return sub(x, y.value);
+            }
+
+        };
+
+
+        /// @brief Subtract specialization for measurements
+        template <typename T1, typename T2>
+            requires (are_same_quantity_v<T1, T2>)
+        struct subtract_impl<measurement<T1>, measurement<T2>> {
+
+            using result_t = measurement<quantity<eval_t<subtract_t<typename T1::value_t, typename T2::value_t>>, typename T1::unit_t>>;
+
+            static constexpr result_t f(const measurement<T1>& x, const measurement<T2>& y) {
+
+                using ratio_t = conversion_t<typename T2::unit_t, typename T1::unit_t>;
+                return { sub(x.val, scale<ratio_t>(y.val)), sqrt(add(sq(x.unc), sq(scale<ratio_t>(y.unc)))) };
+
+            }
+
+        };
+
+
+        /// @brief Subtract-assign specialization for arrays, computed in place
+        template <typename T1, typename T2, size_t N>
+        struct subtract_assign_impl<std::array<T1, N>, std::array<T2, N>> {
+
+            static constexpr void f(std::array<T1, N>& x, const std::array<T2, N>& y) noexcept {
+
+                if constexpr (std::is_same_v<T1, T2> && simd::use_kernel_v<T1, N>) {
+                    if !consteval {
+                        simd::binary<simd::op::sub>(x.data(), y.data(), x.data(), N);
+                        return;
+                    }
+                }
+
+                for (size_t i = 0; i < N; ++i)
+                    sub_assign(x[i], y[i]);
+
+            }
+
+        };
+
+
+        /// @brief Subtract-assign specialization for vectors and spans, evaluated in place in a single pass
+        /// @note  The evaluation is element-wise, so y can be an expression referring to x.
+        template <typename T1, typename T2>
+            requires (is_expression_operand_v<T1> && !is_expression_v<T1> && is_expression_v<subtract_t<T1, T2>>)
+        struct subtract_assign_impl<T1, T2> {
+
+            static constexpr void f(T1& x, const T2& y) {
+                sub(x, y).eval_into(x);
+            }
+
+        };
+
+
+        /// @brief Subtract-assign specialization for quantities, computed in place in the unit of x
+        template <typename T1, typename T2>
+            requires (are_same_quantity_v<T1, T2>)
+        struct subtract_assign_impl<T1, T2> {
+
+            static constexpr void f(T1& x, const T2& y) {
+                sub_assign(x.value, scale<conversion_t<typename T2::unit_t, typename T1::unit_t>>(y.value));
+            }
+
+        };
+
+
+    } // namespace math
+
+
+} // namespace ctda
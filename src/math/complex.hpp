@@ -0,0 +1,109 @@
+/**
+ * @file    math/complex.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the conjugate, the magnitude and the phase of complex numbers, complex vectors and their quantities.
+ * @date    2023-11-28
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    namespace math {
+
+
+        /// @brief Get the complex conjugate of a complex number.
+        template <typename T>
+        constexpr std::complex<T> conj(const std::complex<T>& z) noexcept {
+
+            return {z.real(), -z.imag()};
+
+        }
+
+        /// @brief Get the complex conjugates of a complex vector: the real plane is copied, the imaginary one negated.
+        template <typename T, typename ALLOC_T>
+        complex_vector<T, ALLOC_T> conj(const complex_vector<T, ALLOC_T>& z) {
+
+            complex_vector<T, ALLOC_T> result(typename complex_vector<T, ALLOC_T>::plane_t(z.re, memory::rebind_allocator<T>(z.get_allocator())),
+                                              typename complex_vector<T, ALLOC_T>::plane_t(z.size(), memory::rebind_allocator<T>(z.get_allocator())));
+            simd::unary<simd::op::neg>(z.im.data(), result.im.data(), z.size());
+            return result;
+
+        }
+
+
+        /// @brief Get the magnitude of a complex number.
+        template <typename T>
+        T abs(const std::complex<T>& z) noexcept {
+
+            return std::abs(z);
+
+        }
+
+        /// @brief Get the magnitudes of a complex vector, in a vector allocated like its planes.
+        /// @note  As by 'std::abs', the magnitudes do not overflow nor underflow when the squares of the parts would.
+        template <typename T, typename ALLOC_T>
+        std::vector<T, ALLOC_T> abs(const complex_vector<T, ALLOC_T>& z) {
+
+            std::vector<T, ALLOC_T> result(z.size(), memory::rebind_allocator<T>(z.get_allocator()));
+            simd::complex_abs(z.re.data(), z.im.data(), result.data(), z.size());
+            return result;
+
+        }
+
+
+        /// @brief Get the phase of a complex number, in radians.
+        template <typename T>
+        T arg(const std::complex<T>& z) noexcept {
+
+            return std::arg(z);
+
+        }
+
+        /// @brief Get the phases of a complex vector in radians, in a vector allocated like its planes.
+        template <typename T, typename ALLOC_T>
+        std::vector<T, ALLOC_T> arg(const complex_vector<T, ALLOC_T>& z) {
+
+            std::vector<T, ALLOC_T> result(z.size(), memory::rebind_allocator<T>(z.get_allocator()));
+            simd::complex_arg(z.re.data(), z.im.data(), result.data(), z.size());
+            return result;
+
+        }
+
+
+        /// @brief Get the complex conjugate of a complex quantity, in its unit.
+        template <typename VALUE_T, typename UNIT_T>
+            requires (is_complex_v<VALUE_T> || is_complex_vector_v<VALUE_T>)
+        constexpr quantity<VALUE_T, UNIT_T> conj(const quantity<VALUE_T, UNIT_T>& z) {
+
+            return math::conj(z.value);
+
+        }
+
+        /// @brief Get the magnitude of a complex quantity, in its unit.
+        template <typename VALUE_T, typename UNIT_T>
+            requires (is_complex_v<VALUE_T> || is_complex_vector_v<VALUE_T>)
+        auto abs(const quantity<VALUE_T, UNIT_T>& z) {
+
+            return quantity<decltype(math::abs(z.value)), UNIT_T>(math::abs(z.value));
+
+        }
+
+        /// @brief Get the phase of a complex quantity, a dimensionless angle in radians.
+        template <typename VALUE_T, typename UNIT_T>
+            requires (is_complex_v<VALUE_T> || is_complex_vector_v<VALUE_T>)
+        auto arg(const quantity<VALUE_T, UNIT_T>& z) {
+
+            return quantity<decltype(math::arg(z.value)), unit<dimensionless>>(math::arg(z.value));
+
+        }
+
+
+    } // namespace math
+
+
+} // namespace ctda
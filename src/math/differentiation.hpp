@@ -0,0 +1,90 @@
+/**
+ * @file    math/differentiation.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the forward mode differentiation of quantities and the first order propagation of uncertainties it gives.
+ * @date    2023-11-27
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    namespace math {
+
+
+        /// @brief Seed the variable i of N: a quantity whose derivative with respect to itself is one.
+        template <size_t N, typename T, typename UNIT_T>
+            requires (is_unit_v<UNIT_T>)
+        constexpr quantity<dual<T, N>, UNIT_T> variable(const quantity<T, UNIT_T>& x, size_t i) noexcept {
+
+            return dual<T, N>::variable(x.value, i);
+
+        }
+
+
+        /// @brief Get the value of a quantity of dual numbers, without its derivatives.
+        template <typename T, size_t N, typename UNIT_T>
+        constexpr quantity<T, UNIT_T> primal(const quantity<dual<T, N>, UNIT_T>& y) noexcept {
+
+            return y.value.val;
+
+        }
+
+
+        /// @brief Get the derivative of y with respect to the variable x, in the unit of y over the unit of x.
+        /// @note  x must have been seeded by 'variable': its index is the one of its unit tangent.
+        template <typename T, size_t N, typename Y_UNIT_T, typename X_UNIT_T>
+        constexpr quantity<T, divide_t<Y_UNIT_T, X_UNIT_T>> derivative(const quantity<dual<T, N>, Y_UNIT_T>& y, const quantity<dual<T, N>, X_UNIT_T>& x) noexcept {
+
+            for (size_t i = 0; i < N; ++i)
+                if (x.value.d[i] != T(0))
+                    return y.value.d[i];
+            return T(0);
+
+        }
+
+        /// @brief Get the derivative of y with respect to the variable i, whose unit is X_UNIT_T.
+        template <typename X_UNIT_T, typename T, size_t N, typename Y_UNIT_T>
+            requires (is_unit_v<X_UNIT_T>)
+        constexpr quantity<T, divide_t<Y_UNIT_T, X_UNIT_T>> derivative(const quantity<dual<T, N>, Y_UNIT_T>& y, size_t i) noexcept {
+
+            return y.value.d[i];
+
+        }
+
+
+        /// @brief Propagate the uncertainties of independent measurements through f to first order.
+        /// @note  f is evaluated once on quantities of dual numbers, seeded as one variable for each input,
+        ///        so the exact derivatives of the result come out of a single pass instead of finite differences.
+        ///        f must be generic enough to accept them, and must return a quantity.
+        template <typename FUNCTION_T, typename... INPUTS_T>
+            requires (sizeof...(INPUTS_T) > 0 && ((is_measurement_v<INPUTS_T> && std::is_floating_point_v<typename INPUTS_T::value_t>) && ...))
+        auto propagate(const FUNCTION_T& f, const INPUTS_T&... inputs) {
+
+            using value_t = std::common_type_t<float, typename INPUTS_T::value_t...>;
+            constexpr size_t N = sizeof...(INPUTS_T);
+
+            return [&]<size_t... I>(std::index_sequence<I...>) {
+
+                const auto y = f(variable<N>(quantity<value_t, typename INPUTS_T::unit_t>(static_cast<value_t>(inputs.val)), I)...);
+                using result_t = std::remove_const_t<decltype(y)>;
+                static_assert(is_quantity_v<result_t> && std::is_same_v<typename result_t::value_t, dual<value_t, N>>,
+                              "The function propagated must return a quantity of the dual numbers of its inputs");
+
+                value_t variance = 0;
+                ((variance += sq(y.value.d[I] * static_cast<value_t>(inputs.unc))), ...);
+                return measurement<quantity<value_t, typename result_t::unit_t>>(y.value.val, std::sqrt(variance));
+
+            }(std::index_sequence_for<INPUTS_T...>{});
+
+        }
+
+
+    } // namespace math
+
+
+} // namespace ctda
@@ -0,0 +1,171 @@
+/**
+ * @file    math/linear_algebra.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the matrix product and the dot product of matrices, vectors and their quantities.
+ * @date    2023-11-29
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    namespace math {
+
+
+        /// @brief Number of multiply-adds of a product for which the packing of the blocked kernel pays off
+        inline constexpr size_t gemm_threshold = 4096;
+
+
+        /// @brief Get the dot product of two arrays.
+        template <typename T1, typename T2, size_t N>
+        constexpr multiply_t<T1, T2> dot(const std::array<T1, N>& x, const std::array<T2, N>& y) noexcept {
+
+            if constexpr (std::is_same_v<T1, T2> && simd::use_kernel_v<T1, N>) {
+                if !consteval {
+                    return simd::dot(x.data(), y.data(), N);
+                }
+            }
+
+            multiply_t<T1, T2> result{};
+            for (size_t i = 0; i < N; ++i)
+                result = add(result, mult(x[i], y[i]));
+            return result;
+
+        }
+
+        /// @brief Get the dot product of two contiguous ranges of numbers, such as vectors and spans.
+        template <typename X_T, typename Y_T>
+            requires (std::ranges::contiguous_range<X_T> && std::ranges::contiguous_range<Y_T> &&
+                      std::is_arithmetic_v<std::ranges::range_value_t<X_T>> && std::is_arithmetic_v<std::ranges::range_value_t<Y_T>>)
+        multiply_t<std::ranges::range_value_t<X_T>, std::ranges::range_value_t<Y_T>> dot(const X_T& x, const Y_T& y) {
+
+            using x_t = std::ranges::range_value_t<X_T>;
+            using y_t = std::ranges::range_value_t<Y_T>;
+
+            if (std::ranges::size(x) != std::ranges::size(y))
+                throw std::runtime_error("Cannot compute the dot product of vectors of different sizes");
+
+            const x_t* a = std::ranges::data(x);
+            const y_t* b = std::ranges::data(y);
+            const size_t n = std::ranges::size(x);
+
+            if constexpr (std::is_same_v<x_t, y_t> && simd::is_vectorizable_v<x_t>)
+                return simd::dot(a, b, n);
+            else {
+                multiply_t<x_t, y_t> result{};
+                for (size_t i = 0; i < n; ++i)
+                    result += a[i] * b[i];
+                return result;
+            }
+
+        }
+
+
+        /// @brief Get the matrix product of two matrices stored as arrays of rows.
+        /// @note  Large products of floating point matrices run on the cache-blocked kernel,
+        ///        the others on a loop over the rows of the right operand, which reads them contiguously.
+        template <typename T1, typename T2, size_t M, size_t K, size_t N>
+        constexpr std::array<std::array<multiply_t<T1, T2>, N>, M> matmul(const std::array<std::array<T1, K>, M>& a, const std::array<std::array<T2, N>, K>& b) {
+
+            using value_t = multiply_t<T1, T2>;
+            std::array<std::array<value_t, N>, M> result{};
+
+            if constexpr (std::is_same_v<T1, T2> && simd::is_vectorizable_v<T1> && M * N * K >= gemm_threshold) {
+                static_assert(sizeof(std::array<T1, K>) == K * sizeof(T1) && sizeof(std::array<T1, N>) == N * sizeof(T1));
+                if !consteval {
+                    simd::gemm(M, N, K, a[0].data(), K, b[0].data(), N, result[0].data(), N);
+                    return result;
+                }
+            }
+
+            for (size_t i = 0; i < M; ++i)
+                for (size_t p = 0; p < K; ++p)
+                    for (size_t j = 0; j < N; ++j)
+                        result[i][j] = add(result[i][j], mult(a[i][p], b[p][j]));
+            return result;
+
+        }
+
+        /// @brief Get the product of a matrix stored as an array of rows and a column vector.
+        template <typename T1, typename T2, size_t M, size_t K>
+        constexpr std::array<multiply_t<T1, T2>, M> matmul(const std::array<std::array<T1, K>, M>& a, const std::array<T2, K>& x) noexcept {
+
+            std::array<multiply_t<T1, T2>, M> result{};
+            for (size_t i = 0; i < M; ++i)
+                result[i] = dot(a[i], x);
+            return result;
+
+        }
+
+
+        /// @brief Get the matrix product of two quantities, in the product of their units.
+        template <typename T1, typename T2>
+            requires (are_quantity_v<T1, T2> && requires (const T1& x, const T2& y) { matmul(x.value, y.value); })
+        constexpr auto matmul(const T1& x, const T2& y) {
+
+            return quantity<decltype(matmul(x.value, y.value)), multiply_t<typename T1::unit_t, typename T2::unit_t>>(matmul(x.value, y.value));
+
+        }
+
+        /// @brief Get the dot product of two quantities, in the product of their units.
+        template <typename T1, typename T2>
+            requires (are_quantity_v<T1, T2> && requires (const T1& x, const T2& y) { dot(x.value, y.value); })
+        constexpr auto dot(const T1& x, const T2& y) {
+
+            return quantity<decltype(dot(x.value, y.value)), multiply_t<typename T1::unit_t, typename T2::unit_t>>(dot(x.value, y.value));
+
+        }
+
+
+        /// @brief Write the matrix product of two quantities viewing row-major matrices into a third one.
+        /// @note  The buffers are not owned, so heap-allocated matrices of any size are multiplied with no copy but the packing
+        ///        of the blocked kernel. The unit of the result must have the base of the product of the units of the operands,
+        ///        the result being converted to its prefix, and its buffer must not overlap the ones of the operands.
+        template <typename T1, typename UNIT1_T, typename T2, typename UNIT2_T, typename T, typename UNIT_T>
+            requires (std::is_same_v<std::remove_const_t<T1>, T> && std::is_same_v<std::remove_const_t<T2>, T> && !std::is_const_v<T> &&
+                      std::is_same_v<typename UNIT_T::base_t, typename multiply_t<UNIT1_T, UNIT2_T>::base_t>)
+        void matmul(const quantity_mdview<T1, UNIT1_T, 2>& x, const quantity_mdview<T2, UNIT2_T, 2>& y, const quantity_mdview<T, UNIT_T, 2>& out) {
+
+            const size_t m = x.value.extent(0), k = x.value.extent(1), n = y.value.extent(1);
+            if (y.value.extent(0) != k || out.value.extent(0) != m || out.value.extent(1) != n)
+                throw std::runtime_error("Cannot multiply matrices of incompatible shapes");
+
+            T* c = out.value.data();
+            const T* a = x.value.data();
+            const T* b = y.value.data();
+
+            bool blocked = false;
+            if constexpr (simd::is_vectorizable_v<T>)
+                if (m * n * k >= gemm_threshold) {
+                    simd::gemm(m, n, k, a, k, b, n, c, n);
+                    blocked = true;
+                }
+
+            if (!blocked)
+                for (size_t i = 0; i < m; ++i) {
+                    std::fill_n(c + i * n, n, T(0));
+                    for (size_t p = 0; p < k; ++p)
+                        for (size_t j = 0; j < n; ++j)
+                            c[i * n + j] += a[i * k + p] * b[p * n + j];
+                }
+
+            using ratio_t = conversion_t<multiply_t<UNIT1_T, UNIT2_T>, UNIT_T>;
+            if constexpr (!std::ratio_equal_v<ratio_t, std::ratio<1>>) {
+                if constexpr (simd::is_vectorizable_v<T>)
+                    scale_op<ratio_t>::block(c, m * n, c);
+                else
+                    for (size_t i = 0; i < m * n; ++i)
+                        c[i] = scale<ratio_t>(c[i]);
+            }
+
+        }
+
+
+    } // namespace math
+
+
+} // namespace ctda
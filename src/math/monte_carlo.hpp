@@ -0,0 +1,235 @@
+/**
+ * @file    math/monte_carlo.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the Monte Carlo propagation of the uncertainties of measurements through a function.
+ * @date    2023-11-26
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    namespace math {
+
+
+        /// @brief This struct draws a stream of standard normal deviates from the Philox4x32-10 counter-based generator.
+        /// @note  The deviate i of a stream depends only on the seed, on the stream and on i,
+        ///        so the deviates can be drawn in any order and split among any number of threads reproducibly.
+        ///        The uniform numbers are drawn with the SIMD kernels, and turned into normal ones with the Box-Muller transform.
+        struct normal_stream {
+
+
+            /// @brief Number of deviates drawn from a block of the generator.
+            static constexpr size_t block_size = 2 * simd::philox_lanes;
+
+
+            uint64_t seed = 0;
+
+            uint32_t stream = 0;
+
+
+            /// @brief Write the deviates of 'blocks' blocks into out, starting from the deviate 'first_block * block_size'.
+            void fill(uint64_t first_block, double* out, size_t blocks) const noexcept {
+
+                constexpr size_t batch = 8;
+                constexpr size_t words = 4 * simd::philox_lanes;
+                constexpr size_t L = simd::philox_lanes;
+
+                const std::array<uint32_t, 2> key{static_cast<uint32_t>(this->seed), static_cast<uint32_t>(this->seed >> 32)};
+                std::array<uint32_t, batch * words> bits;
+
+                for (size_t b = 0; b < blocks; b += batch) {
+
+                    const size_t count = std::min(batch, blocks - b);
+                    const uint64_t counter = (first_block + b) * L;
+                    simd::philox(key, {static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), this->stream, 0}, bits.data(), count);
+
+                    for (size_t k = 0; k < count; ++k) {
+
+                        const uint32_t* w = bits.data() + k * words;
+                        double* z = out + (b + k) * block_size;
+                        for (size_t l = 0; l < L; ++l) {
+                            const double r = std::sqrt(-2 * std::log(uniform(w[l], w[L + l])));
+                            const double theta = 2 * std::numbers::pi * uniform(w[2 * L + l], w[3 * L + l]);
+                            z[l] = r * std::cos(theta);
+                            z[L + l] = r * std::sin(theta);
+                        }
+
+                    }
+
+                }
+
+            }
+
+
+            /// @brief Get a uniform number in (0, 1) from 53 random bits of two words.
+            static constexpr double uniform(uint32_t hi, uint32_t lo) noexcept {
+
+                return (static_cast<double>(((static_cast<uint64_t>(hi) << 32) | lo) >> 11) + 0.5) * 0x1p-53;
+
+            }
+
+
+        }; // struct normal_stream
+
+
+        /// @brief This template meta-struct contains the distribution of a quantity propagated by 'monte_carlo'.
+        /// @note  The samples are kept sorted, so that the quantiles are read in constant time.
+        /// @tparam QUANTITY_T: the quantity computed, with a floating point value
+        template <typename QUANTITY_T>
+            requires (is_quantity_v<QUANTITY_T> && std::is_floating_point_v<typename QUANTITY_T::value_t>)
+        struct monte_carlo_result {
+
+
+            using value_t = typename QUANTITY_T::value_t;
+
+            using unit_t = typename QUANTITY_T::unit_t;
+
+            using quantity_t = QUANTITY_T;
+
+            using measurement_t = measurement<quantity_t>;
+
+
+            std::vector<value_t> samples;               //< sorted samples of the quantity
+
+            accumulator<quantity_t> moments;            //< moments of the samples
+
+
+            /// @brief Get the number of samples.
+            size_t size() const noexcept {
+
+                return this->samples.size();
+
+            }
+
+            /// @brief Get the mean of the samples.
+            quantity_t mean() const noexcept {
+
+                return this->moments.mean().value;
+
+            }
+
+            /// @brief Get the standard deviation of the samples: the standard uncertainty of the quantity.
+            quantity_t stddev() const noexcept {
+
+                return this->moments.stddev().value;
+
+            }
+
+            /// @brief Get the quantile of probability p, interpolating linearly between the samples.
+            quantity_t quantile(double p) const noexcept {
+
+                if (this->samples.empty())
+                    return value_t{};
+
+                const double h = std::clamp(p, 0.0, 1.0) * static_cast<double>(this->samples.size() - 1);
+                const size_t i = static_cast<size_t>(h);
+                if (i + 1 >= this->samples.size())
+                    return this->samples.back();
+                return this->samples[i] + static_cast<value_t>(h - static_cast<double>(i)) * (this->samples[i + 1] - this->samples[i]);
+
+            }
+
+            quantity_t median() const noexcept {
+
+                return this->quantile(0.5);
+
+            }
+
+            /// @brief Get the probabilistically symmetric interval containing the fraction 'coverage' of the samples.
+            std::pair<quantity_t, quantity_t> interval(double coverage) const noexcept {
+
+                return {this->quantile((1 - coverage) / 2), this->quantile((1 + coverage) / 2)};
+
+            }
+
+
+            /// @brief Get the mean of the samples with their standard deviation.
+            measurement_t estimate() const noexcept {
+
+                return {this->mean(), this->stddev()};
+
+            }
+
+            operator measurement_t() const noexcept {
+
+                return this->estimate();
+
+            }
+
+
+        }; // struct monte_carlo_result
+
+
+        /// @brief Propagate the uncertainties of the measurements through f, evaluating it on 'samples' samples of the inputs.
+        /// @note  Each input is drawn from a normal distribution centred on its value, with its uncertainty as standard deviation,
+        ///        from its own stream of deviates. f is called with the quantities of the inputs and must return a quantity,
+        ///        so that the units of the formula are checked at compile time. The samples are split among the threads
+        ///        of the policy, and the result depends only on the seed, never on the number of threads.
+        /// @return The distribution of the quantity computed, sorted.
+        template <typename POLICY_T, typename FUNCTION_T, typename... INPUTS_T>
+            requires (is_execution_policy_v<std::remove_cvref_t<POLICY_T>> && sizeof...(INPUTS_T) > 0 &&
+                      ((is_measurement_v<INPUTS_T> && std::is_floating_point_v<typename INPUTS_T::value_t>) && ...) &&
+                      std::is_invocable_v<const FUNCTION_T&, typename INPUTS_T::quantity_t...>)
+        auto monte_carlo(POLICY_T&& policy, const FUNCTION_T& f, size_t samples, uint64_t seed, const INPUTS_T&... inputs) {
+
+            using result_t = std::invoke_result_t<const FUNCTION_T&, typename INPUTS_T::quantity_t...>;
+            static_assert(is_quantity_v<result_t> && std::is_floating_point_v<typename result_t::value_t>,
+                          "The function propagated must return a quantity with a floating point value");
+
+            constexpr size_t block_size = 256;
+            static_assert(block_size % normal_stream::block_size == 0);
+
+            monte_carlo_result<result_t> result;
+            result.samples.resize(samples);
+            typename result_t::value_t* out = result.samples.data();
+
+            const auto run = [&](size_t begin, size_t end) {
+
+                std::array<std::array<double, block_size>, sizeof...(INPUTS_T)> deviates;
+
+                for (size_t i = begin; i < end; i += block_size) {
+
+                    const size_t count = std::min(block_size, end - i);
+                    const size_t blocks = (count + normal_stream::block_size - 1) / normal_stream::block_size;
+                    for (uint32_t k = 0; k < sizeof...(INPUTS_T); ++k)
+                        normal_stream{seed, k}.fill(i / normal_stream::block_size, deviates[k].data(), blocks);
+
+                    [&]<size_t... K>(std::index_sequence<K...>) {
+                        for (size_t j = 0; j < count; ++j)
+                            out[i + j] = f(typename INPUTS_T::quantity_t(static_cast<typename INPUTS_T::value_t>(inputs.val + inputs.unc * deviates[K][j]))...).value;
+                    }(std::index_sequence_for<INPUTS_T...>{});
+
+                }
+
+            };
+
+            // chunks start on a block, so that each sample is drawn from the same deviates whatever the split
+            if (thread_pool* pool = policy_pool(policy))
+                pool->parallel_for(samples, 16 * block_size, run);
+            else
+                run(0, samples);
+
+            std::ranges::sort(result.samples);
+            result.moments.push(quantity<std::span<const typename result_t::value_t>, typename result_t::unit_t>(result.samples));
+            return result;
+
+        }
+
+        template <typename FUNCTION_T, typename... INPUTS_T>
+            requires (sizeof...(INPUTS_T) > 0 && (is_measurement_v<INPUTS_T> && ...))
+        auto monte_carlo(const FUNCTION_T& f, size_t samples, uint64_t seed, const INPUTS_T&... inputs) {
+
+            return monte_carlo(seq, f, samples, seed, inputs...);
+
+        }
+
+
+    } // namespace math
+
+
+} // namespace ctda
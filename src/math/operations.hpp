@@ -75,7 +75,11 @@ namespace ctda {
         struct negate_impl; 
 
         template <typename T>
-        inline static constexpr auto neg(const T& x) noexcept {
+        using negate_t = typename negate_impl<T>::result_t;
+
+        /// @brief Return -x, noexcept unless its specialization may throw, as the ones of measurements
+        template <typename T>
+        inline static constexpr auto neg(const T& x) noexcept(noexcept(negate_impl<T>::f(x))) {
             
             return negate_impl<T>::f(x); 
 
@@ -89,17 +93,99 @@ namespace ctda {
         using add_t = typename add_impl<T1, T2>::result_t;
 
         template <typename T1, typename T2>
-        inline static constexpr auto add(const T1& x, const T2& y) noexcept {
+        inline static constexpr auto add(const T1& x, const T2& y) {
             
             return add_impl<T1, T2>::f(x, y); 
 
         }
+
+
+        /// @brief Add-assign fallback for the types without an in-place specialization: x = x + y
+        template <typename T1, typename T2>
+        struct add_assign_impl {
+
+            static constexpr void f(T1& x, const T2& y) {
+                x = add(x, y);
+            }
+
+        };
+
+        /// @brief Add y to x in place
+        template <typename T1, typename T2>
+        inline static constexpr void add_assign(T1& x, const T2& y) {
+
+            add_assign_impl<T1, T2>::f(x, y);
+
+        }
         
 
+        template <typename RATIO_T, typename T>
+        struct scale_impl;
+
+        template <typename RATIO_T, typename T>
+        using scale_t = typename scale_impl<RATIO_T, T>::result_t;
+
+        /// @brief Scale a value by the compile-time ratio RATIO_T
+        template <typename RATIO_T, typename T>
+        inline static constexpr decltype(auto) scale(const T& x) noexcept {
+
+            return scale_impl<RATIO_T, T>::f(x);
+
+        }
+
+        /// @brief Convert a quantity or a measurement to another unit with the same base
+        template <typename UNIT_T, typename T>
+            requires (is_unit_v<UNIT_T> && (is_quantity_v<T> || is_measurement_v<T>))
+        inline static constexpr auto convert(const T& x) noexcept {
+
+            using ratio_t = conversion_t<typename T::unit_t, UNIT_T>;
+
+            if constexpr (is_quantity_v<T>)
+                return quantity<eval_t<scale_t<ratio_t, typename T::value_t>>, UNIT_T>(scale<ratio_t>(x.value));
+            else
+                return measurement<quantity<eval_t<scale_t<ratio_t, typename T::value_t>>, UNIT_T>>(scale<ratio_t>(x.val), scale<ratio_t>(x.unc));
+
+        }
+
+
+        /// @brief Subtract fallback for the types without a native specialization: x + (-y)
+        template <typename T1, typename T2>
+        struct subtract_impl {
+
+            using result_t = add_t<T1, negate_t<T2>>;
+
+            static constexpr result_t f(const T1& x, const T2& y) {
+                return add(x, neg(y));
+            }
+
+        };
+
+        template <typename T1, typename T2>
+        using subtract_t = typename subtract_impl<T1, T2>::result_t;
+
         template <typename T1, typename T2>
-        inline static constexpr auto sub(const T1& x, const T2& y) noexcept {
+        inline static constexpr auto sub(const T1& x, const T2& y) {
             
-            return add(x, neg(y)); 
+            return subtract_impl<T1, T2>::f(x, y); 
+
+        }
+
+
+        /// @brief Subtract-assign fallback for the types without an in-place specialization: x = x - y
+        template <typename T1, typename T2>
+        struct subtract_assign_impl {
+
+            static constexpr void f(T1& x, const T2& y) {
+                x = sub(x, y);
+            }
+
+        };
+
+        /// @brief Subtract y from x in place
+        template <typename T1, typename T2>
+        inline static constexpr void sub_assign(T1& x, const T2& y) {
+
+            subtract_assign_impl<T1, T2>::f(x, y);
 
         }
 
@@ -111,13 +197,32 @@ namespace ctda {
         using multiply_t = typename multiply_impl<T1, T2>::result_t;
     
         template <typename T1, typename T2>
-        inline static constexpr auto mult(const T1& x, const T2& y) noexcept {
+        inline static constexpr auto mult(const T1& x, const T2& y) {
             
             return multiply_impl<T1, T2>::f(x, y); 
 
         }
 
 
+        /// @brief Multiply-assign fallback for the types without an in-place specialization: x = x * y
+        template <typename T1, typename T2>
+        struct multiply_assign_impl {
+
+            static constexpr void f(T1& x, const T2& y) {
+                x = mult(x, y);
+            }
+
+        };
+
+        /// @brief Multiply x by y in place
+        template <typename T1, typename T2>
+        inline static constexpr void mult_assign(T1& x, const T2& y) {
+
+            multiply_assign_impl<T1, T2>::f(x, y);
+
+        }
+
+
         template <typename T>
         struct invert_impl;       
 
@@ -132,13 +237,44 @@ namespace ctda {
         }
 
 
+        /// @brief Divide fallback for the types without a native specialization: x * (1 / y)
         template <typename T1, typename T2>
-        using divide_t = multiply_t<T1, invert_t<T2>>;
+        struct divide_impl {
+
+            using result_t = multiply_t<T1, invert_t<T2>>;
+
+            static constexpr result_t f(const T1& x, const T2& y) {
+                return mult(x, inv(y));
+            }
+
+        };
+
+        template <typename T1, typename T2>
+        using divide_t = typename divide_impl<T1, T2>::result_t;
     
         template <typename T1, typename T2>
-        inline static constexpr auto div(const T1& x, const T2& y) noexcept {
+        inline static constexpr auto div(const T1& x, const T2& y) {
             
-            return mult(x, inv(y));
+            return divide_impl<T1, T2>::f(x, y);
+
+        }
+
+
+        /// @brief Divide-assign fallback for the types without an in-place specialization: x = x / y
+        template <typename T1, typename T2>
+        struct divide_assign_impl {
+
+            static constexpr void f(T1& x, const T2& y) {
+                x = div(x, y);
+            }
+
+        };
+
+        /// @brief Divide x by y in place
+        template <typename T1, typename T2>
+        inline static constexpr void div_assign(T1& x, const T2& y) {
+
+            divide_assign_impl<T1, T2>::f(x, y);
 
         }
 
@@ -149,8 +285,9 @@ namespace ctda {
         template <int POWER, typename T>
         using power_t = typename power_impl<POWER, T>::result_t;
 
+        /// @brief Return x raised to POWER, noexcept unless its specialization may throw, as the one of dynamic quantities
         template <int POWER, typename T>
-        inline static constexpr auto pow(const T& x) noexcept {
+        inline static constexpr auto pow(const T& x) noexcept(noexcept(power_impl<POWER, T>::f(x))) {
             
             return power_impl<POWER, T>::f(x); 
 
@@ -160,7 +297,7 @@ namespace ctda {
         template <typename T>
         using square_t = power_t<2, T>;
 
-        inline static constexpr auto sq(const auto& x) noexcept {
+        inline static constexpr auto sq(const auto& x) noexcept(noexcept(pow<2>(x))) {
             
             return pow<2>(x); 
 
@@ -169,7 +306,7 @@ namespace ctda {
         template <typename T>
         using cube_t = power_t<3, T>;
 
-        inline static constexpr auto cb(const auto& x) noexcept {
+        inline static constexpr auto cb(const auto& x) noexcept(noexcept(pow<3>(x))) {
             
             return pow<3>(x); 
 
@@ -194,11 +331,182 @@ namespace ctda {
 
         }
 
-        // inline static constexpr auto cbrt(const auto& x) {
+        inline static constexpr auto cbrt(const auto& x) {
             
-        //     return pow<1. / 3.>(x); 
+            return root<3>(x); 
+
+        }
+
+        /// @brief Return the reciprocal of the square root, with a single division after the square root
+        inline static constexpr auto rsqrt(const auto& x) {
+            
+            return root<-2>(x); 
+
+        }
+
+
+        /// @brief Element-wise 'neg' used as node of a lazy expression
+        struct negate_op {
+
+            template <typename T>
+            static constexpr bool vectorizable = simd::is_vectorizable_v<T>;
+
+            static constexpr auto f(const auto& x) noexcept {
+                return neg(x);
+            }
+
+            template <typename T>
+            static void block(T* out, size_t n, const T* x) noexcept {
+                simd::unary<simd::op::neg>(x, out, n);
+            }
+
+        };
+
+        /// @brief Element-wise 'add' used as node of a lazy expression
+        struct add_op {
+
+            template <typename T>
+            static constexpr bool vectorizable = simd::is_vectorizable_v<T>;
+
+            static constexpr auto f(const auto& x, const auto& y) noexcept {
+                return add(x, y);
+            }
+
+            template <typename T>
+            static void block(T* out, size_t n, const auto& x, const auto& y) noexcept {
+                simd::binary<simd::op::add>(x, y, out, n);
+            }
+
+        };
+
+        /// @brief Element-wise 'scale' used as node of a lazy expression
+        template <typename RATIO_T>
+        struct scale_op {
+
+            template <typename T>
+            static constexpr bool vectorizable = simd::is_vectorizable_v<T>;
+
+            static constexpr auto f(const auto& x) noexcept {
+                return scale<RATIO_T>(x);
+            }
+
+            template <typename T>
+            static void block(T* out, size_t n, const T* x) noexcept {
+
+                if constexpr (RATIO_T::den == 1)
+                    simd::binary<simd::op::mult>(x, static_cast<T>(RATIO_T::num), out, n);
+                else if constexpr (RATIO_T::num == 1)
+                    simd::binary<simd::op::div>(x, static_cast<T>(RATIO_T::den), out, n);
+                else 
+                    simd::binary<simd::op::mult>(x, static_cast<T>(static_cast<long double>(RATIO_T::num) / RATIO_T::den), out, n);
+
+            }
+
+        };
+
+        /// @brief Element-wise 'sub' used as node of a lazy expression
+        struct subtract_op {
+
+            template <typename T>
+            static constexpr bool vectorizable = simd::is_vectorizable_v<T>;
+
+            static constexpr auto f(const auto& x, const auto& y) noexcept {
+                return sub(x, y);
+            }
+
+            template <typename T>
+            static void block(T* out, size_t n, const auto& x, const auto& y) noexcept {
+                simd::binary<simd::op::sub>(x, y, out, n);
+            }
+
+        };
+
+        /// @brief Element-wise 'mult' used as node of a lazy expression
+        struct multiply_op {
+
+            template <typename T>
+            static constexpr bool vectorizable = simd::is_vectorizable_v<T>;
+
+            static constexpr auto f(const auto& x, const auto& y) noexcept {
+                return mult(x, y);
+            }
+
+            template <typename T>
+            static void block(T* out, size_t n, const auto& x, const auto& y) noexcept {
+                simd::binary<simd::op::mult>(x, y, out, n);
+            }
+
+        };
+
+        /// @brief Element-wise 'div' used as node of a lazy expression
+        struct divide_op {
+
+            template <typename T>
+            static constexpr bool vectorizable = simd::is_vectorizable_v<T>;
+
+            static constexpr auto f(const auto& x, const auto& y) noexcept {
+                return div(x, y);
+            }
+
+            template <typename T>
+            static void block(T* out, size_t n, const auto& x, const auto& y) noexcept {
+                simd::binary<simd::op::div>(x, y, out, n);
+            }
+
+        };
+
+        /// @brief Element-wise 'inv' used as node of a lazy expression
+        struct invert_op {
+
+            template <typename T>
+            static constexpr bool vectorizable = simd::is_vectorizable_v<T>;
+
+            static constexpr auto f(const auto& x) noexcept {
+                return inv(x);
+            }
+
+            template <typename T>
+            static void block(T* out, size_t n, const T* x) noexcept {
+                simd::unary<simd::op::inv>(x, out, n);
+            }
+
+        };
+
+        /// @brief Element-wise 'pow' used as node of a lazy expression
+        template <int POWER>
+        struct power_op {
+
+            template <typename T>
+            static constexpr bool vectorizable = simd::is_vectorizable_v<T>;
+
+            static constexpr auto f(const auto& x) noexcept {
+                return pow<POWER>(x);
+            }
+
+            template <typename T>
+            static void block(T* out, size_t n, const T* x) noexcept {
+                simd::unary<simd::op::pow, POWER>(x, out, n);
+            }
+
+        };
+
+        /// @brief Element-wise 'root' used as node of a lazy expression
+        template <int POWER>
+        struct root_op {
+
+            template <typename T>
+            static constexpr bool vectorizable = simd::is_vectorizable_v<T> && simd::has_root_kernel_v<POWER>;
+
+            static constexpr auto f(const auto& x) noexcept {
+                return root<POWER>(x);
+            }
+
+            template <typename T>
+            static void block(T* out, size_t n, const T* x) noexcept {
+                simd::unary<simd::op::root, POWER>(x, out, n);
+            }
 
-        // }
+        };
 
 
     
@@ -62,7 +62,7 @@ namespace ctda {
 
 
     /// @brief Negate operator 
-    inline static constexpr auto operator-(auto x) noexcept { 
+    inline static constexpr auto operator-(const auto& x) { 
         
         return math::neg(x);
         
@@ -70,7 +70,7 @@ namespace ctda {
     
 
     /// @brief Addition operator
-    inline static constexpr auto operator+(auto x, auto y) noexcept { 
+    inline static constexpr auto operator+(const auto& x, const auto& y) { 
 
         return math::add(x, y);
         
@@ -78,7 +78,7 @@ namespace ctda {
 
 
     /// @brief Subtraction operator
-    inline static constexpr auto operator-(auto x, auto y) noexcept { 
+    inline static constexpr auto operator-(const auto& x, const auto& y) { 
         
         return math::sub(x, y);
         
@@ -86,7 +86,7 @@ namespace ctda {
 
 
     /// @brief Multiplication operator
-    inline static constexpr auto operator*(auto x, auto y) noexcept { 
+    inline static constexpr auto operator*(const auto& x, const auto& y) { 
         
         return math::mult(x, y);
         
@@ -94,41 +94,45 @@ namespace ctda {
 
 
     /// @brief Division operator
-    inline static constexpr auto operator/(auto x, auto y) noexcept { 
+    inline static constexpr auto operator/(const auto& x, const auto& y) { 
 
         return math::div(x, y);
         
     }
 
 
-    /// @brief Increment operator
-    inline static constexpr auto operator+=(auto& x, const auto& y) noexcept { 
+    /// @brief Increment operator, computed in place
+    inline static constexpr auto& operator+=(auto& x, const auto& y) { 
         
-        return x = math::add(x, y);
+        math::add_assign(x, y);
+        return x;
         
     }
 
-    /// @brief Decrement operator
-    inline static constexpr auto operator-=(auto& x, const auto& y) noexcept { 
+    /// @brief Decrement operator, computed in place
+    inline static constexpr auto& operator-=(auto& x, const auto& y) { 
         
-        return x = math::sub(x, y);
+        math::sub_assign(x, y);
+        return x;
         
     }
 
-    /// @brief Scale operator
+    /// @brief Scale operator, computed in place
     template <typename T>
-    inline static constexpr auto operator*=(auto& x, const T& y) noexcept { 
+    inline static constexpr auto& operator*=(auto& x, const T& y) { 
 
-        return x = math::mult(x, y);
+        math::mult_assign(x, y);
+        return x;
         
     }
 
 
-    /// @brief Scale operator
+    /// @brief Scale operator, computed in place
     template <typename T>
-    inline static constexpr auto operator/=(auto& x, const T& y) {
+    inline static constexpr auto& operator/=(auto& x, const T& y) {
 
-        return x = math::div(x, y);
+        math::div_assign(x, y);
+        return x;
         
     }
 
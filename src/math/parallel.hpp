@@ -0,0 +1,160 @@
+/**
+ * @file    math/parallel.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the overloads of the element-wise operations taking an execution policy.
+ * @date    2023-11-15
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    namespace math {
+
+
+        /// @brief Get the pool running an execution policy, nullptr for the sequenced policy.
+        inline thread_pool* policy_pool(const sequenced_policy&) noexcept {
+            return nullptr;
+        }
+
+        inline thread_pool* policy_pool(const parallel_policy& policy) noexcept {
+            return policy.pool ? policy.pool : &thread_pool::global();
+        }
+
+        inline thread_pool* policy_pool(thread_pool& pool) noexcept {
+            return &pool;
+        }
+
+
+        /// @brief Operand of a parallel operation: arrays are viewed as spans, so that the operation is built lazily.
+        /// @note  The other operands, vectors included, are passed by reference and never copied.
+        template <typename T>
+        constexpr decltype(auto) parallel_operand(const T& x) noexcept {
+
+            if constexpr (is_quantity_v<T>) {
+                if constexpr (std::is_reference_v<decltype(parallel_operand(x.value))>)
+                    return (x);
+                else
+                    return quantity<std::remove_cvref_t<decltype(parallel_operand(x.value))>, typename T::unit_t>(parallel_operand(x.value));
+            }
+            else if constexpr (requires { typename std::tuple_size<T>::type; x.data(); })
+                return std::span<const typename T::value_type>(x);
+            else
+                return (x);
+
+        }
+
+
+        /// @brief Evaluate the lazy result of an element-wise operation into RESULT_T with an execution policy.
+        /// @note  The result is allocated as the one of a sequential evaluation, from the operands or the current arena.
+        template <typename RESULT_T, typename POLICY_T, typename T>
+        RESULT_T parallel_eval(POLICY_T&& policy, const T& lazy) {
+
+            if constexpr (is_quantity_v<T>)
+                return parallel_eval<typename RESULT_T::value_t>(policy, lazy.value);
+            else if constexpr (is_expression_v<T>) {
+
+                RESULT_T result = memory::make_container<RESULT_T>(lazy);
+                if (thread_pool* pool = policy_pool(policy))
+                    lazy.eval_into(result, *pool);
+                else
+                    lazy.eval_into(result);
+                return result;
+
+            }
+            else
+                return lazy;
+
+        }
+
+
+        /// @brief Add two values, evaluating the elements with an execution policy
+        template <typename POLICY_T, typename T1, typename T2>
+            requires (is_execution_policy_v<std::remove_cvref_t<POLICY_T>>)
+        inline static auto add(POLICY_T&& policy, const T1& x, const T2& y) {
+
+            return parallel_eval<eval_t<add_t<T1, T2>>>(policy, add(parallel_operand(x), parallel_operand(y)));
+
+        }
+
+        /// @brief Subtract two values, evaluating the elements with an execution policy
+        template <typename POLICY_T, typename T1, typename T2>
+            requires (is_execution_policy_v<std::remove_cvref_t<POLICY_T>>)
+        inline static auto sub(POLICY_T&& policy, const T1& x, const T2& y) {
+
+            return parallel_eval<eval_t<subtract_t<T1, T2>>>(policy, sub(parallel_operand(x), parallel_operand(y)));
+
+        }
+
+        /// @brief Multiply two values, evaluating the elements with an execution policy
+        template <typename POLICY_T, typename T1, typename T2>
+            requires (is_execution_policy_v<std::remove_cvref_t<POLICY_T>>)
+        inline static auto mult(POLICY_T&& policy, const T1& x, const T2& y) {
+
+            return parallel_eval<eval_t<multiply_t<T1, T2>>>(policy, mult(parallel_operand(x), parallel_operand(y)));
+
+        }
+
+        /// @brief Divide two values, evaluating the elements with an execution policy
+        template <typename POLICY_T, typename T1, typename T2>
+            requires (is_execution_policy_v<std::remove_cvref_t<POLICY_T>>)
+        inline static auto div(POLICY_T&& policy, const T1& x, const T2& y) {
+
+            return parallel_eval<eval_t<divide_t<T1, T2>>>(policy, div(parallel_operand(x), parallel_operand(y)));
+
+        }
+
+
+        /// @brief Negate a value, evaluating the elements with an execution policy
+        template <typename POLICY_T, typename T>
+            requires (is_execution_policy_v<std::remove_cvref_t<POLICY_T>>)
+        inline static auto neg(POLICY_T&& policy, const T& x) {
+
+            return parallel_eval<eval_t<negate_t<T>>>(policy, neg(parallel_operand(x)));
+
+        }
+
+        /// @brief Invert a value, evaluating the elements with an execution policy
+        template <typename POLICY_T, typename T>
+            requires (is_execution_policy_v<std::remove_cvref_t<POLICY_T>>)
+        inline static auto inv(POLICY_T&& policy, const T& x) {
+
+            return parallel_eval<eval_t<invert_t<T>>>(policy, inv(parallel_operand(x)));
+
+        }
+
+        /// @brief Raise a value to POWER, evaluating the elements with an execution policy
+        template <int POWER, typename POLICY_T, typename T>
+            requires (is_execution_policy_v<std::remove_cvref_t<POLICY_T>>)
+        inline static auto pow(POLICY_T&& policy, const T& x) {
+
+            return parallel_eval<eval_t<power_t<POWER, T>>>(policy, pow<POWER>(parallel_operand(x)));
+
+        }
+
+        /// @brief Take the POWER-th root of a value, evaluating the elements with an execution policy
+        template <int POWER, typename POLICY_T, typename T>
+            requires (is_execution_policy_v<std::remove_cvref_t<POLICY_T>>)
+        inline static auto root(POLICY_T&& policy, const T& x) {
+
+            return parallel_eval<eval_t<root_t<POWER, T>>>(policy, root<POWER>(parallel_operand(x)));
+
+        }
+
+        template <typename POLICY_T, typename T>
+            requires (is_execution_policy_v<std::remove_cvref_t<POLICY_T>>)
+        inline static auto sqrt(POLICY_T&& policy, const T& x) {
+
+            return root<2>(policy, x);
+
+        }
+
+
+    } // namespace math
+
+
+} // namespace ctda
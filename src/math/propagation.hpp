@@ -0,0 +1,537 @@
+/**
+ * @file    math/propagation.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the linear propagation of correlated uncertainties through sparse sensitivities.
+ * @date    2023-11-25
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    /// @brief Identifier of an independent source of uncertainty.
+    using source_id = uint32_t;
+
+
+    /// @brief This struct names the independent sources of uncertainty, like the calibration of an instrument shared by many channels.
+    /// @note  A name is registered once, then the measurements refer to its source by the identifier.
+    ///        The registry is shared by all the threads.
+    struct error_sources {
+
+
+        /// @brief Get the identifier of the source named 'name', registering it the first time.
+        static source_id declare(std::string_view name) {
+
+            registry& r = get();
+            std::lock_guard lock(r.mutex);
+
+            if (r.ids.contains(name))
+                return r.ids.find(name)->second;
+
+            const source_id id = static_cast<source_id>(r.names.size());
+            r.ids.emplace(r.names.emplace_back(name), id);
+            return id;
+
+        }
+
+        /// @brief Get the identifier of a new source without a name, like the statistical error of a single reading.
+        static source_id declare() {
+
+            registry& r = get();
+            std::lock_guard lock(r.mutex);
+
+            r.names.emplace_back();
+            return static_cast<source_id>(r.names.size() - 1);
+
+        }
+
+        /// @brief Get the name of a source.
+        static std::string_view name(source_id id) {
+
+            registry& r = get();
+            std::lock_guard lock(r.mutex);
+            return r.names.at(id);
+
+        }
+
+        /// @brief Get the number of sources registered.
+        static size_t size() {
+
+            registry& r = get();
+            std::lock_guard lock(r.mutex);
+            return r.names.size();
+
+        }
+
+
+      private:
+
+
+        struct hash : std::hash<std::string_view> {
+
+            using is_transparent = void;
+
+        };
+
+        struct registry {
+
+            std::mutex mutex;
+
+            std::deque<std::string> names;      //< names of the sources, by identifier
+
+            std::unordered_map<std::string_view, source_id, hash, std::equal_to<>> ids;
+
+        };
+
+        static registry& get() noexcept {
+
+            static registry r;
+            return r;
+
+        }
+
+
+    }; // struct error_sources
+
+
+    /// @brief This namespace contains the terms of the propagation,
+    ///        kept apart so that the operators of 'ctda' are not found for their containers by argument dependent lookup.
+    namespace propagation {
+
+
+        /// @brief Sensitivity of a value to a source of uncertainty.
+        template <typename T>
+        struct sensitivity {
+
+            source_id source;
+
+            T weight;       //< derivative of the value with respect to the source, times the standard uncertainty of the source
+
+        }; // struct sensitivity
+
+
+    } // namespace propagation
+
+
+    using propagation::sensitivity;
+
+
+    /// @brief This template meta-struct contains a measurement that keeps track of the sources of its uncertainty.
+    /// @note  The uncertainty is propagated linearly: each value stores its sensitivities to the sources it depends on,
+    ///        sorted by source, and each operation merges the sensitivities of its operands in a single pass.
+    ///        The uncertainties and the covariances are collapsed only when requested, so 'x - x' is exact
+    ///        and an error shared by many values is never counted as independent.
+    ///        The sensitivities are allocated from the memory resource of the calling thread, like the containers of the operations.
+    /// @tparam The quantity measured, with a floating point value.
+    template <typename QUANTITY_T>
+        requires (is_quantity_v<QUANTITY_T> && std::is_floating_point_v<typename QUANTITY_T::value_t>)
+    struct correlated {
+
+        using value_t = QUANTITY_T::value_t;
+
+        using unit_t = QUANTITY_T::unit_t;
+
+        using quantity_t = QUANTITY_T;
+
+        using measurement_t = measurement<quantity_t>;
+
+        using term_t = sensitivity<value_t>;
+
+        using terms_t = std::pmr::vector<term_t>;
+
+
+        /// @brief Constructor of an exact value.
+        correlated(const value_t& val = {}) : val{val}, terms{memory::resource()} {}
+
+        correlated(const quantity_t& val) : correlated(val.value) {}
+
+        /// @brief Constructor of a value whose uncertainty comes from a single source.
+        correlated(const value_t& val, const value_t& unc, source_id source) : correlated(val) {
+
+            if (unc != 0)
+                this->terms.push_back({source, unc});
+
+        }
+
+        correlated(const quantity_t& val, const quantity_t& unc, source_id source) : correlated(val.value, unc.value, source) {}
+
+        correlated(const measurement_t& m, source_id source) : correlated(m.val, m.unc, source) {}
+
+        /// @brief Constructor from the sensitivities, sorted by source.
+        correlated(const value_t& val, terms_t&& terms) noexcept : val{val}, terms{std::move(terms)} {}
+
+
+        constexpr quantity_t value() const noexcept {
+
+            return this->val;
+
+        }
+
+        /// @brief Get the variance, summing the squared contributions of the sources.
+        quantity<value_t, math::square_t<unit_t>> variance() const noexcept {
+
+            value_t result{};
+            for (const term_t& t : this->terms)
+                result += t.weight * t.weight;
+            return result;
+
+        }
+
+        quantity_t uncertainty() const noexcept {
+
+            return std::sqrt(this->variance().value);
+
+        }
+
+        /// @brief Get the contribution of a source to the uncertainty, signed by the direction of the dependence.
+        quantity_t contribution(source_id source) const noexcept {
+
+            const term_t* last = this->terms.data() + this->terms.size();
+            const term_t* it = std::ranges::lower_bound(this->terms.data(), last, source, {}, &term_t::source);
+            return it != last && it->source == source ? it->weight : value_t{};
+
+        }
+
+        /// @brief Get the sensitivities to the sources, sorted by source.
+        std::span<const term_t> sources() const noexcept {
+
+            return this->terms;
+
+        }
+
+
+        /// @brief Collapse the sources into the total uncertainty.
+        operator measurement_t() const noexcept {
+
+            return {this->val, this->uncertainty().value};
+
+        }
+
+
+        value_t val;
+
+        terms_t terms;
+
+
+    }; // struct correlated
+
+
+    namespace math {
+
+
+        /// @brief Merge the sensitivities of the linear combination a x + b y, dropping the sources that cancel.
+        template <typename T>
+        std::pmr::vector<sensitivity<T>> combine(std::span<const sensitivity<T>> x, T a, std::span<const sensitivity<T>> y, T b) {
+
+            std::pmr::vector<sensitivity<T>> result(memory::resource());
+            result.reserve(x.size() + y.size());
+
+            size_t i = 0, j = 0;
+            while (i < x.size() && j < y.size()) {
+                if (x[i].source < y[j].source) {
+                    result.push_back({x[i].source, a * x[i].weight});
+                    ++i;
+                }
+                else if (y[j].source < x[i].source) {
+                    result.push_back({y[j].source, b * y[j].weight});
+                    ++j;
+                }
+                else {
+                    if (const T w = a * x[i].weight + b * y[j].weight; w != 0)
+                        result.push_back({x[i].source, w});
+                    ++i, ++j;
+                }
+            }
+            for (; i < x.size(); ++i)
+                result.push_back({x[i].source, a * x[i].weight});
+            for (; j < y.size(); ++j)
+                result.push_back({y[j].source, b * y[j].weight});
+
+            return result;
+
+        }
+
+        /// @brief Scale the sensitivities of x by a.
+        template <typename T>
+        std::pmr::vector<sensitivity<T>> combine(std::span<const sensitivity<T>> x, T a) {
+
+            std::pmr::vector<sensitivity<T>> result(memory::resource());
+            if (a == 0)
+                return result;
+
+            result.reserve(x.size());
+            for (const sensitivity<T>& t : x)
+                result.push_back({t.source, a * t.weight});
+            return result;
+
+        }
+
+
+        /// @brief Get the covariance of two correlated measurements, from the sources they share.
+        template <typename T1, typename T2>
+            requires (std::is_same_v<typename T1::value_t, typename T2::value_t>)
+        quantity<typename T1::value_t, multiply_t<typename T1::unit_t, typename T2::unit_t>> covariance(const correlated<T1>& x, const correlated<T2>& y) noexcept {
+
+            const auto a = x.sources(), b = y.sources();
+            typename T1::value_t result{};
+
+            size_t i = 0, j = 0;
+            while (i < a.size() && j < b.size()) {
+                if (a[i].source < b[j].source)
+                    ++i;
+                else if (b[j].source < a[i].source)
+                    ++j;
+                else
+                    result += a[i++].weight * b[j++].weight;
+            }
+
+            return result;
+
+        }
+
+        /// @brief Get the correlation coefficient of two correlated measurements.
+        template <typename T1, typename T2>
+            requires (std::is_same_v<typename T1::value_t, typename T2::value_t>)
+        typename T1::value_t correlation(const correlated<T1>& x, const correlated<T2>& y) noexcept {
+
+            const auto norm = x.uncertainty().value * y.uncertainty().value;
+            return norm != 0 ? covariance(x, y).value / norm : typename T1::value_t{};
+
+        }
+
+        /// @brief Collapse the covariance matrix of a set of correlated measurements, stored by rows.
+        /// @note  Only the measurements requested are collapsed, each entry merging the sensitivities of a pair.
+        template <typename T>
+        std::vector<typename T::value_t> covariance_matrix(std::span<const correlated<T>> xs) {
+
+            const size_t n = xs.size();
+            std::vector<typename T::value_t> result(n * n);
+            for (size_t i = 0; i < n; ++i) {
+                result[i * n + i] = xs[i].variance().value;
+                for (size_t j = i + 1; j < n; ++j)
+                    result[i * n + j] = result[j * n + i] = covariance(xs[i], xs[j]).value;
+            }
+            return result;
+
+        }
+
+
+        /// @brief Negate specialization for correlated measurements
+        template <typename T>
+        struct negate_impl<correlated<T>> {
+
+            using result_t = correlated<T>;
+
+            static result_t f(const correlated<T>& x) {
+                return { -x.val, combine(x.sources(), typename T::value_t(-1)) };
+            }
+
+        };
+
+
+        /// @brief Add specialization for correlated measurements, the common sources adding their sensitivities
+        template <typename T1, typename T2>
+            requires (are_same_quantity_v<T1, T2> && std::is_same_v<typename T1::value_t, typename T2::value_t>)
+        struct add_impl<correlated<T1>, correlated<T2>> {
+
+            using result_t = correlated<T1>;
+
+            static result_t f(const correlated<T1>& x, const correlated<T2>& y) {
+
+                using ratio_t = conversion_t<typename T2::unit_t, typename T1::unit_t>;
+                using value_t = typename T1::value_t;
+                return { x.val + scale<ratio_t>(y.val), combine(x.sources(), value_t(1), y.sources(), scale<ratio_t>(value_t(1))) };
+
+            }
+
+        };
+
+        /// @brief Add specialization for correlated measurements and exact quantities
+        template <typename T1, typename T2>
+            requires (are_same_quantity_v<T1, T2>)
+        struct add_impl<correlated<T1>, T2> {
+
+            using result_t = correlated<T1>;
+
+            static result_t f(const correlated<T1>& x, const T2& y) {
+                return { x.val + scale<conversion_t<typename T2::unit_t, typename T1::unit_t>>(y.value), combine(x.sources(), typename T1::value_t(1)) };
+            }
+
+        };
+
+        template <typename T1, typename T2>
+            requires (are_same_quantity_v<T1, T2>)
+        struct add_impl<T1, correlated<T2>> {
+
+            using result_t = correlated<T2>;
+
+            static result_t f(const T1& x, const correlated<T2>& y) {
+                return add(y, x);
+            }
+
+        };
+
+
+        /// @brief Subtract specialization for correlated measurements, so that the common sources cancel
+        template <typename T1, typename T2>
+            requires (are_same_quantity_v<T1, T2> && std::is_same_v<typename T1::value_t, typename T2::value_t>)
+        struct subtract_impl<correlated<T1>, correlated<T2>> {
+
+            using result_t = correlated<T1>;
+
+            static result_t f(const correlated<T1>& x, const correlated<T2>& y) {
+
+                using ratio_t = conversion_t<typename T2::unit_t, typename T1::unit_t>;
+                using value_t = typename T1::value_t;
+                return { x.val - scale<ratio_t>(y.val), combine(x.sources(), value_t(1), y.sources(), -scale<ratio_t>(value_t(1))) };
+
+            }
+
+        };
+
+
+        /// @brief Multiply specialization for correlated measurements
+        template <typename T1, typename T2>
+            requires (std::is_same_v<typename T1::value_t, typename T2::value_t>)
+        struct multiply_impl<correlated<T1>, correlated<T2>> {
+
+            using result_t = correlated<quantity<typename T1::value_t, multiply_t<typename T1::unit_t, typename T2::unit_t>>>;
+
+            static result_t f(const correlated<T1>& x, const correlated<T2>& y) {
+                return { x.val * y.val, combine(x.sources(), y.val, y.sources(), x.val) };
+            }
+
+        };
+
+        /// @brief Multiply specialization for correlated measurements and numbers
+        template <typename T1, typename T2>
+            requires (std::is_arithmetic_v<T2>)
+        struct multiply_impl<correlated<T1>, T2> {
+
+            using result_t = correlated<T1>;
+
+            static result_t f(const correlated<T1>& x, const T2& y) {
+
+                const auto a = static_cast<typename T1::value_t>(y);
+                return { x.val * a, combine(x.sources(), a) };
+
+            }
+
+        };
+
+        template <typename T1, typename T2>
+            requires (std::is_arithmetic_v<T1>)
+        struct multiply_impl<T1, correlated<T2>> {
+
+            using result_t = correlated<T2>;
+
+            static result_t f(const T1& x, const correlated<T2>& y) {
+                return mult(y, x);
+            }
+
+        };
+
+
+        /// @brief Multiply specialization for correlated measurements and exact quantities
+        template <typename T1, typename T2>
+            requires (is_quantity_v<T2> && std::is_arithmetic_v<typename T2::value_t>)
+        struct multiply_impl<correlated<T1>, T2> {
+
+            using result_t = correlated<quantity<typename T1::value_t, multiply_t<typename T1::unit_t, typename T2::unit_t>>>;
+
+            static result_t f(const correlated<T1>& x, const T2& y) {
+
+                const auto a = static_cast<typename T1::value_t>(y.value);
+                return { x.val * a, combine(x.sources(), a) };
+
+            }
+
+        };
+
+        template <typename T1, typename T2>
+            requires (is_quantity_v<T1> && std::is_arithmetic_v<typename T1::value_t>)
+        struct multiply_impl<T1, correlated<T2>> {
+
+            using result_t = correlated<quantity<typename T2::value_t, multiply_t<typename T1::unit_t, typename T2::unit_t>>>;
+
+            static result_t f(const T1& x, const correlated<T2>& y) {
+
+                const auto a = static_cast<typename T2::value_t>(x.value);
+                return { a * y.val, combine(y.sources(), a) };
+
+            }
+
+        };
+
+
+        /// @brief Invert specialization for correlated measurements
+        template <typename T>
+        struct invert_impl<correlated<T>> {
+
+            using result_t = correlated<quantity<typename T::value_t, invert_t<typename T::unit_t>>>;
+
+            static result_t f(const correlated<T>& x) {
+                return { 1 / x.val, combine(x.sources(), -1 / (x.val * x.val)) };
+            }
+
+        };
+
+
+        /// @brief Divide specialization for correlated measurements, merging the sensitivities in a single pass
+        template <typename T1, typename T2>
+            requires (std::is_same_v<typename T1::value_t, typename T2::value_t>)
+        struct divide_impl<correlated<T1>, correlated<T2>> {
+
+            using result_t = correlated<quantity<typename T1::value_t, divide_t<typename T1::unit_t, typename T2::unit_t>>>;
+
+            static result_t f(const correlated<T1>& x, const correlated<T2>& y) {
+
+                const auto ratio = x.val / y.val;
+                return { ratio, combine(x.sources(), 1 / y.val, y.sources(), -ratio / y.val) };
+
+            }
+
+        };
+
+        /// @brief Divide specialization for correlated measurements and numbers
+        template <typename T1, typename T2>
+            requires (std::is_arithmetic_v<T2>)
+        struct divide_impl<correlated<T1>, T2> {
+
+            using result_t = correlated<T1>;
+
+            static result_t f(const correlated<T1>& x, const T2& y) {
+
+                const auto a = 1 / static_cast<typename T1::value_t>(y);
+                return { x.val * a, combine(x.sources(), a) };
+
+            }
+
+        };
+
+
+        /// @brief Divide specialization for correlated measurements and exact quantities
+        template <typename T1, typename T2>
+            requires (is_quantity_v<T2> && std::is_arithmetic_v<typename T2::value_t>)
+        struct divide_impl<correlated<T1>, T2> {
+
+            using result_t = correlated<quantity<typename T1::value_t, divide_t<typename T1::unit_t, typename T2::unit_t>>>;
+
+            static result_t f(const correlated<T1>& x, const T2& y) {
+
+                const auto a = 1 / static_cast<typename T1::value_t>(y.value);
+                return { x.val * a, combine(x.sources(), a) };
+
+            }
+
+        };
+
+
+    } // namespace math
+
+
+} // namespace ctda
@@ -0,0 +1,1363 @@
+/**
+ * @file    math/simd.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the SIMD kernels used by the element-wise operations.
+ * @date    2023-11-08
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+#if CTDA_USE_SIMD && defined(__x86_64__) && defined(__GNUC__)
+    #define CTDA_SIMD_X86 1
+    #include <immintrin.h>
+#else
+    #define CTDA_SIMD_X86 0
+#endif
+
+
+// The generic kernels are always inlined into the ISA specific dispatchers,
+// so the vector ABI of their (never emitted) default-target instances does not matter.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+
+namespace ctda {
+
+
+    namespace math {
+
+
+        /// @brief This namespace contains the SIMD kernels with runtime dispatch on the instruction set.
+        namespace simd {
+
+
+            /// @brief Instruction sets supported by the kernels
+            enum class isa { scalar, sse2, avx2, avx512 };
+
+            /// @brief Detect the best instruction set available on the running cpu.
+            /// @note  The AVX2 kernels of the products and of the half precision conversions use FMA and F16C too,
+            ///        which virtual machines and emulators may mask while exposing AVX2, so the tier requires all three.
+            inline isa detect() noexcept {
+
+                #if CTDA_SIMD_X86
+                    __builtin_cpu_init();
+                    if (__builtin_cpu_supports("avx512f"))
+                        return isa::avx512;
+                    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c"))
+                        return isa::avx2;
+                    return isa::sse2;
+                #else
+                    return isa::scalar;
+                #endif
+
+            }
+
+            /// @brief Get the instruction set used by the kernels, detected once.
+            inline isa level() noexcept {
+
+                static const isa detected = detect();
+                return detected;
+
+            }
+
+
+            /// @brief Element types handled by the kernels
+            template <typename T>
+            inline constexpr bool is_vectorizable_v = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+            /// @brief Number of elements for which a fixed size container is worth a kernel call
+            template <typename T, size_t N>
+            inline constexpr bool use_kernel_v = CTDA_USE_SIMD && is_vectorizable_v<T> && N * sizeof(T) >= 64;
+
+            /// @brief Operations implemented by the kernels
+            enum class op { add, sub, mult, div, neg, inv, pow, root };
+
+
+            /// @brief Raise x to the integer power POWER in place, by squaring unrolled at compile time:
+            ///        floor(log2 |POWER|) squares, a product for each other bit set and a single reciprocal if POWER < 0.
+            /// @note  x is a number or a register of numbers, so the scalar and the vector code run the same products,
+            ///        and it is taken by reference so that no register crosses a call boundary.
+            template <int POWER, typename T>
+            [[gnu::always_inline]] constexpr void raise(T& x) noexcept {
+
+                if constexpr (POWER < 0) {
+                    raise<-POWER>(x);
+                    x = (T{} + 1) / x;
+                }
+                else if constexpr (POWER == 0)
+                    x = T{} + 1;
+                else if constexpr (POWER > 1) {
+                    const T base = x;
+                    raise<POWER / 2>(x);
+                    x *= x;
+                    if constexpr (POWER % 2 == 1)
+                        x *= base;
+                }
+
+            }
+
+
+            /// @brief Take the root of index POWER of a number in place, with the specialised functions:
+            ///        a square root for each factor 2 of POWER, a cube root for each factor 3 and a single reciprocal if POWER < 0.
+            /// @note  Only the other factors, from 5 on, fall back to 'std::pow'.
+            template <int POWER, typename T>
+            [[gnu::always_inline]] constexpr void extract(T& x) noexcept {
+
+                static_assert(POWER != 0, "Cannot take a root of index zero");
+
+                if constexpr (POWER < 0) {
+                    extract<-POWER>(x);
+                    x = T(1) / x;
+                }
+                else if constexpr (POWER % 2 == 0) {
+                    x = std::sqrt(x);
+                    extract<POWER / 2>(x);
+                }
+                else if constexpr (POWER % 3 == 0) {
+                    x = std::cbrt(x);
+                    extract<POWER / 3>(x);
+                }
+                else if constexpr (POWER > 1)
+                    x = std::pow(x, T(1) / POWER);
+
+            }
+
+            /// @brief Check if the root of index POWER has a kernel: a chain of square roots, then a reciprocal if POWER < 0.
+            template <int POWER>
+            inline constexpr bool has_root_kernel_v = POWER != 0 && std::has_single_bit(static_cast<unsigned>(POWER < 0 ? -POWER : POWER));
+
+
+            /// @brief Packed register of BYTES bytes of T
+            template <typename T, size_t BYTES>
+            struct pack {
+                typedef T type __attribute__((vector_size(BYTES)));
+            };
+
+
+            /// @brief Binary kernel on BYTES wide registers, each operand is a pointer or a broadcasted scalar.
+            template <op OP, size_t BYTES, typename T, typename X_T, typename Y_T>
+            [[gnu::always_inline]] inline void binary_kernel(const X_T x, const Y_T y, T* out, size_t n) noexcept {
+
+                using v_t = typename pack<T, BYTES>::type;
+                constexpr size_t W = BYTES / sizeof(T);
+
+                const size_t blocks = n / W;
+                for (size_t k = 0; k < blocks; ++k) {
+
+                    const size_t i = k * W;
+                    v_t a, b, r;
+                    if constexpr (std::is_pointer_v<X_T>)
+                        std::memcpy(&a, x + i, BYTES);
+                    else
+                        a = v_t{} + x;
+                    if constexpr (std::is_pointer_v<Y_T>)
+                        std::memcpy(&b, y + i, BYTES);
+                    else
+                        b = v_t{} + y;
+
+                    if constexpr (OP == op::add)
+                        r = a + b;
+                    else if constexpr (OP == op::sub)
+                        r = a - b;
+                    else if constexpr (OP == op::mult)
+                        r = a * b;
+                    else
+                        r = a / b;
+
+                    std::memcpy(out + i, &r, BYTES);
+
+                }
+
+                for (size_t i = blocks * W; i < n; ++i) {
+
+                    T a, b;
+                    if constexpr (std::is_pointer_v<X_T>)
+                        a = x[i];
+                    else
+                        a = x;
+                    if constexpr (std::is_pointer_v<Y_T>)
+                        b = y[i];
+                    else
+                        b = y;
+
+                    if constexpr (OP == op::add)
+                        out[i] = a + b;
+                    else if constexpr (OP == op::sub)
+                        out[i] = a - b;
+                    else if constexpr (OP == op::mult)
+                        out[i] = a * b;
+                    else
+                        out[i] = a / b;
+
+                }
+
+            }
+
+
+            /// @brief Unary kernel on BYTES wide registers, POWER is used by the 'pow' operation.
+            template <op OP, int POWER, size_t BYTES, typename T>
+            [[gnu::always_inline]] inline void unary_kernel(const T* x, T* out, size_t n) noexcept {
+
+                using v_t = typename pack<T, BYTES>::type;
+                constexpr size_t W = BYTES / sizeof(T);
+
+                size_t i = 0;
+                for (; i + W <= n; i += W) {
+
+                    v_t a, r;
+                    std::memcpy(&a, x + i, BYTES);
+
+                    if constexpr (OP == op::neg)
+                        r = -a;
+                    else if constexpr (OP == op::inv)
+                        r = T(1) / a;
+                    else {
+                        r = a;
+                        raise<POWER>(r);
+                    }
+
+                    std::memcpy(out + i, &r, BYTES);
+
+                }
+
+                for (; i < n; ++i) {
+
+                    if constexpr (OP == op::neg)
+                        out[i] = -x[i];
+                    else if constexpr (OP == op::inv)
+                        out[i] = T(1) / x[i];
+                    else {
+                        T r = x[i];
+                        raise<POWER>(r);
+                        out[i] = r;
+                    }
+
+                }
+
+            }
+
+
+            /// @brief Reduction kernel on BYTES wide registers: sum and sum of squares of the deviations of x from 'shift'.
+            /// @note  Shifting by a value close to the mean avoids the cancellation of the one-pass formula.
+            template <size_t BYTES, typename T>
+            [[gnu::always_inline]] inline std::pair<T, T> moments_kernel(const T* x, size_t n, T shift) noexcept {
+
+                using v_t = typename pack<T, BYTES>::type;
+                constexpr size_t W = BYTES / sizeof(T);
+
+                v_t s1{}, s2{}, t1{}, t2{};
+                const v_t c = v_t{} + shift;
+
+                size_t i = 0;
+                for (; i + 2 * W <= n; i += 2 * W) {
+
+                    v_t a, b;
+                    std::memcpy(&a, x + i, BYTES);
+                    std::memcpy(&b, x + i + W, BYTES);
+                    a -= c;
+                    b -= c;
+                    s1 += a;
+                    s2 += a * a;
+                    t1 += b;
+                    t2 += b * b;
+
+                }
+
+                s1 += t1;
+                s2 += t2;
+
+                T sum{}, sum_sq{};
+                for (size_t k = 0; k < W; ++k) {
+                    sum += s1[k];
+                    sum_sq += s2[k];
+                }
+
+                for (; i < n; ++i) {
+                    const T d = x[i] - shift;
+                    sum += d;
+                    sum_sq += d * d;
+                }
+
+                return {sum, sum_sq};
+
+            }
+
+
+            /// @brief Reduction kernel on BYTES wide registers: the dot product of x and y.
+            template <size_t BYTES, typename T>
+            [[gnu::always_inline]] inline T dot_kernel(const T* x, const T* y, size_t n) noexcept {
+
+                using v_t = typename pack<T, BYTES>::type;
+                constexpr size_t W = BYTES / sizeof(T);
+
+                v_t s{}, t{};
+
+                size_t i = 0;
+                for (; i + 2 * W <= n; i += 2 * W) {
+
+                    v_t a, b, c, d;
+                    std::memcpy(&a, x + i, BYTES);
+                    std::memcpy(&b, y + i, BYTES);
+                    std::memcpy(&c, x + i + W, BYTES);
+                    std::memcpy(&d, y + i + W, BYTES);
+                    s += a * b;
+                    t += c * d;
+
+                }
+
+                s += t;
+
+                T sum{};
+                for (size_t k = 0; k < W; ++k)
+                    sum += s[k];
+
+                for (; i < n; ++i)
+                    sum += x[i] * y[i];
+
+                return sum;
+
+            }
+
+
+            /// @brief Blocking of the matrix product on BYTES wide registers of T.
+            /// @note  The micro-kernel keeps a tile of MR rows and NR columns of the result in registers.
+            ///        A sliver of KC rows of the packed right operand stays in the L1 cache while it is swept,
+            ///        a block of MC rows of the packed left operand in the L2 cache, a panel of NC columns of the right one in the L3 cache.
+            template <size_t BYTES, typename T>
+            struct gemm_blocking {
+
+                static constexpr size_t W = BYTES / sizeof(T);
+
+                static constexpr size_t MR = 6;
+
+                static constexpr size_t NR = 2 * W;
+
+                static constexpr size_t KC = std::max<size_t>(64, 16384 / (NR * sizeof(T)));
+
+                static constexpr size_t MC = 16 * MR;
+
+                static constexpr size_t NC = 4096 / NR * NR;
+
+            };
+
+
+            /// @brief Micro-kernel of the matrix product: the tile of m <= MR rows and n <= NR columns of c
+            ///        is set to, or incremented by, the product of a packed sliver of a and a packed sliver of b.
+            template <size_t BYTES, typename T>
+            [[gnu::always_inline]] inline void gemm_micro_kernel(size_t kc, const T* a, const T* b, T* c, size_t ldc, size_t m, size_t n, bool accumulate) noexcept {
+
+                using v_t = typename pack<T, BYTES>::type;
+                using blocking = gemm_blocking<BYTES, T>;
+                constexpr size_t W = blocking::W, MR = blocking::MR, NR = blocking::NR;
+
+                v_t acc[MR][2] = {};
+                for (size_t k = 0; k < kc; ++k) {
+
+                    v_t b0, b1;
+                    std::memcpy(&b0, b + k * NR, BYTES);
+                    std::memcpy(&b1, b + k * NR + W, BYTES);
+
+                    for (size_t r = 0; r < MR; ++r) {
+                        const v_t ar = v_t{} + a[k * MR + r];
+                        acc[r][0] += ar * b0;
+                        acc[r][1] += ar * b1;
+                    }
+
+                }
+
+                if (m == MR && n == NR) {
+
+                    for (size_t r = 0; r < MR; ++r) {
+
+                        T* row = c + r * ldc;
+                        if (accumulate) {
+                            v_t c0, c1;
+                            std::memcpy(&c0, row, BYTES);
+                            std::memcpy(&c1, row + W, BYTES);
+                            acc[r][0] += c0;
+                            acc[r][1] += c1;
+                        }
+                        std::memcpy(row, &acc[r][0], BYTES);
+                        std::memcpy(row + W, &acc[r][1], BYTES);
+
+                    }
+
+                } else {
+
+                    T tile[MR * NR];
+                    std::memcpy(tile, acc, sizeof(tile));
+                    for (size_t r = 0; r < m; ++r)
+                        for (size_t j = 0; j < n; ++j)
+                            c[r * ldc + j] = accumulate ? c[r * ldc + j] + tile[r * NR + j] : tile[r * NR + j];
+
+                }
+
+            }
+
+            /// @brief Cache-blocked matrix product on BYTES wide registers: c = a b, with a of m x k and b of k x n elements.
+            /// @note  The matrices are stored by rows, ld being the distance between two rows. Each block of the operands
+            ///        is packed into the order read by the micro-kernel, padded with zeros to whole tiles,
+            ///        in buffers drawn from the memory resource of the calling thread. c must not overlap a or b.
+            template <size_t BYTES, typename T>
+            [[gnu::always_inline]] inline void gemm_kernel(size_t m, size_t n, size_t k, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc) {
+
+                using blocking = gemm_blocking<BYTES, T>;
+                constexpr size_t MR = blocking::MR, NR = blocking::NR, KC = blocking::KC, MC = blocking::MC, NC = blocking::NC;
+
+                if (k == 0) {
+                    for (size_t i = 0; i < m; ++i)
+                        std::fill_n(c + i * ldc, n, T(0));
+                    return;
+                }
+
+                std::pmr::vector<T> a_pack(MC * KC, memory::resource());
+                std::pmr::vector<T> b_pack(std::min(NC, (n + NR - 1) / NR * NR) * KC, memory::resource());
+
+                for (size_t jc = 0; jc < n; jc += NC) {
+
+                    const size_t nc = std::min(NC, n - jc);
+
+                    for (size_t pc = 0; pc < k; pc += KC) {
+
+                        const size_t kc = std::min(KC, k - pc);
+
+                        for (size_t j = 0; j < nc; j += NR)
+                            for (size_t p = 0; p < kc; ++p) {
+                                T* dst = b_pack.data() + j * kc + p * NR;
+                                const T* src = b + (pc + p) * ldb + jc + j;
+                                const size_t len = std::min(NR, nc - j);
+                                std::copy_n(src, len, dst);
+                                std::fill(dst + len, dst + NR, T(0));
+                            }
+
+                        for (size_t ic = 0; ic < m; ic += MC) {
+
+                            const size_t mc = std::min(MC, m - ic);
+
+                            for (size_t i = 0; i < mc; i += MR)
+                                for (size_t p = 0; p < kc; ++p) {
+                                    T* dst = a_pack.data() + i * kc + p * MR;
+                                    for (size_t r = 0; r < MR; ++r)
+                                        dst[r] = i + r < mc ? a[(ic + i + r) * lda + pc + p] : T(0);
+                                }
+
+                            for (size_t j = 0; j < nc; j += NR)
+                                for (size_t i = 0; i < mc; i += MR)
+                                    gemm_micro_kernel<BYTES>(kc, a_pack.data() + i * kc, b_pack.data() + j * kc,
+                                                             c + (ic + i) * ldc + jc + j, ldc,
+                                                             std::min(MR, mc - i), std::min(NR, nc - j), pc > 0);
+
+                        }
+
+                    }
+
+                }
+
+            }
+
+
+
+            /// @brief Widen a packed register of floats into out, as floats or as doubles.
+            template <size_t BYTES, typename D>
+            [[gnu::always_inline]] inline void store_widened(const typename pack<float, BYTES>::type& v, D* out) noexcept {
+
+                if constexpr (std::is_same_v<D, float>)
+                    std::memcpy(out, &v, BYTES);
+                else {
+                    const auto d = __builtin_convertvector(v, typename pack<double, 2 * BYTES>::type);
+                    std::memcpy(out, &d, 2 * BYTES);
+                }
+
+            }
+
+            /// @brief Conversion kernel from the storage type S to the compute type D on BYTES wide registers of floats.
+            /// @note  A bfloat16 is widened shifting its bits into the upper half of a float.
+            template <size_t BYTES, typename S, typename D>
+            [[gnu::always_inline]] inline void widen_kernel(const S* x, D* out, size_t n) noexcept {
+
+                using v_t = typename pack<float, BYTES>::type;
+                constexpr size_t W = BYTES / sizeof(float);
+
+                size_t i = 0;
+                if constexpr (std::is_same_v<S, float> || std::is_same_v<S, bfloat16_t>)
+                    for (; i + W <= n; i += W) {
+
+                        v_t v;
+                        if constexpr (std::is_same_v<S, float>)
+                            std::memcpy(&v, x + i, BYTES);
+                        else {
+                            typename pack<uint16_t, BYTES / 2>::type h;
+                            std::memcpy(&h, x + i, BYTES / 2);
+                            const auto u = __builtin_convertvector(h, typename pack<uint32_t, BYTES>::type) << 16;
+                            std::memcpy(&v, &u, BYTES);
+                        }
+                        store_widened<BYTES>(v, out + i);
+
+                    }
+
+                for (; i < n; ++i)
+                    out[i] = static_cast<D>(static_cast<float>(x[i]));
+
+            }
+
+            /// @brief Conversion kernel from floats to the storage type S on BYTES wide registers, rounding to the nearest even.
+            template <size_t BYTES, typename S>
+            [[gnu::always_inline]] inline void narrow_kernel(const float* x, S* out, size_t n) noexcept {
+
+                using u_t = typename pack<uint32_t, BYTES>::type;
+                constexpr size_t W = BYTES / sizeof(float);
+
+                size_t i = 0;
+                if constexpr (std::is_same_v<S, bfloat16_t>)
+                    for (; i + W <= n; i += W) {
+
+                        u_t u;
+                        std::memcpy(&u, x + i, BYTES);
+                        const u_t rounded = (u + 0x7FFFu + ((u >> 16) & 1u)) >> 16;
+                        const u_t quiet = (u >> 16) | 0x40u;
+                        const u_t r = (u & 0x7FFFFFFFu) > 0x7F800000u ? quiet : rounded;
+                        const auto h = __builtin_convertvector(r, typename pack<uint16_t, BYTES / 2>::type);
+                        std::memcpy(out + i, &h, BYTES / 2);
+
+                    }
+
+                for (; i < n; ++i)
+                    out[i] = static_cast<S>(x[i]);
+
+            }
+
+
+            /// @brief Number of counters of a block of the Philox generator, 4 words are drawn from each of them.
+            inline constexpr size_t philox_lanes = 16;
+
+            /// @brief Philox4x32-10 counter-based generator on BYTES wide registers of 32 bits words.
+            /// @note  The lane l of the block b encrypts the counter (c + 16 b + l, c2, c3) with the key, where the first
+            ///        two words of the counter form a 64 bits integer. Its 4 words j are written at out[64 b + 16 j + l],
+            ///        a layout that does not depend on the width of the registers.
+            template <size_t BYTES>
+            [[gnu::always_inline]] inline void philox_kernel(const std::array<uint32_t, 2>& key, const std::array<uint32_t, 4>& counter, uint32_t* out, size_t blocks) noexcept {
+
+                using v_t = typename pack<uint32_t, BYTES>::type;
+                using w_t = typename pack<uint64_t, 2 * BYTES>::type;
+                constexpr size_t W = BYTES / sizeof(uint32_t);
+                static_assert(philox_lanes % W == 0);
+
+                v_t lane{};
+                for (size_t l = 0; l < W; ++l)
+                    lane[l] = static_cast<uint32_t>(l);
+
+                const uint64_t first = (static_cast<uint64_t>(counter[1]) << 32) | counter[0];
+
+                for (size_t b = 0; b < blocks; ++b)
+                    for (size_t l = 0; l < philox_lanes; l += W) {
+
+                        const uint64_t base = first + b * philox_lanes + l;
+                        v_t x0 = lane + static_cast<uint32_t>(base);
+                        v_t x1 = (v_t{} + static_cast<uint32_t>(base >> 32)) - __builtin_convertvector(x0 < static_cast<uint32_t>(base), v_t);
+                        v_t x2 = v_t{} + counter[2];
+                        v_t x3 = v_t{} + counter[3];
+
+                        uint32_t k0 = key[0], k1 = key[1];
+                        for (int round = 0; round < 10; ++round) {
+
+                            const w_t p0 = __builtin_convertvector(x0, w_t) * 0xD2511F53u;
+                            const w_t p1 = __builtin_convertvector(x2, w_t) * 0xCD9E8D57u;
+                            const v_t hi0 = __builtin_convertvector(p0 >> 32, v_t), lo0 = __builtin_convertvector(p0, v_t);
+                            const v_t hi1 = __builtin_convertvector(p1 >> 32, v_t), lo1 = __builtin_convertvector(p1, v_t);
+
+                            x0 = hi1 ^ x1 ^ k0;
+                            x1 = lo1;
+                            x2 = hi0 ^ x3 ^ k1;
+                            x3 = lo0;
+
+                            k0 += 0x9E3779B9u;
+                            k1 += 0xBB67AE85u;
+
+                        }
+
+                        uint32_t* block = out + b * 4 * philox_lanes + l;
+                        std::memcpy(block, &x0, BYTES);
+                        std::memcpy(block + philox_lanes, &x1, BYTES);
+                        std::memcpy(block + 2 * philox_lanes, &x2, BYTES);
+                        std::memcpy(block + 3 * philox_lanes, &x3, BYTES);
+
+                    }
+
+            }
+
+
+            /// @brief Integer type of the same size of T, used by the masks of the shuffles and of the comparisons.
+            template <typename T>
+            using mask_element_t = std::conditional_t<sizeof(T) == 8, int64_t, int32_t>;
+
+
+            /// @brief Split the interleaved complex numbers of z into their real and imaginary planes on BYTES wide registers.
+            /// @note  z points to the n pairs of parts of an array of 'std::complex<T>', whose layout is the one of T[2].
+            template <size_t BYTES, typename T>
+            [[gnu::always_inline]] inline void deinterleave_kernel(const T* z, T* re, T* im, size_t n) noexcept {
+
+                using v_t = typename pack<T, BYTES>::type;
+                using m_t = typename pack<mask_element_t<T>, BYTES>::type;
+                constexpr size_t W = BYTES / sizeof(T);
+
+                m_t even{}, odd{};
+                for (size_t k = 0; k < W; ++k) {
+                    even[k] = static_cast<mask_element_t<T>>(2 * k);
+                    odd[k] = static_cast<mask_element_t<T>>(2 * k + 1);
+                }
+
+                size_t i = 0;
+                for (; i + W <= n; i += W) {
+
+                    v_t a, b;
+                    std::memcpy(&a, z + 2 * i, BYTES);
+                    std::memcpy(&b, z + 2 * i + W, BYTES);
+                    const v_t r = __builtin_shuffle(a, b, even);
+                    const v_t s = __builtin_shuffle(a, b, odd);
+                    std::memcpy(re + i, &r, BYTES);
+                    std::memcpy(im + i, &s, BYTES);
+
+                }
+
+                for (; i < n; ++i) {
+                    re[i] = z[2 * i];
+                    im[i] = z[2 * i + 1];
+                }
+
+            }
+
+            /// @brief Merge the real and imaginary planes into n interleaved complex numbers on BYTES wide registers.
+            template <size_t BYTES, typename T>
+            [[gnu::always_inline]] inline void interleave_kernel(const T* re, const T* im, T* z, size_t n) noexcept {
+
+                using v_t = typename pack<T, BYTES>::type;
+                using m_t = typename pack<mask_element_t<T>, BYTES>::type;
+                constexpr size_t W = BYTES / sizeof(T);
+
+                // the element j of the output is the part j % 2 of the number j / 2
+                m_t low{}, high{};
+                for (size_t k = 0; k < W; ++k) {
+                    low[k] = static_cast<mask_element_t<T>>((k % 2) * W + k / 2);
+                    high[k] = static_cast<mask_element_t<T>>(((W + k) % 2) * W + (W + k) / 2);
+                }
+
+                size_t i = 0;
+                for (; i + W <= n; i += W) {
+
+                    v_t a, b;
+                    std::memcpy(&a, re + i, BYTES);
+                    std::memcpy(&b, im + i, BYTES);
+                    const v_t r = __builtin_shuffle(a, b, low);
+                    const v_t s = __builtin_shuffle(a, b, high);
+                    std::memcpy(z + 2 * i, &r, BYTES);
+                    std::memcpy(z + 2 * i + W, &s, BYTES);
+
+                }
+
+                for (; i < n; ++i) {
+                    z[2 * i] = re[i];
+                    z[2 * i + 1] = im[i];
+                }
+
+            }
+
+
+            /// @brief Complex multiplication kernel on split planes of BYTES wide registers.
+            /// @note  The planes of y are pointers to n elements, or the parts of a complex number broadcasted to all of them.
+            template <size_t BYTES, typename T, typename Y_T>
+            [[gnu::always_inline]] inline void complex_mult_kernel(const T* xr, const T* xi, const Y_T yr, const Y_T yi, T* re, T* im, size_t n) noexcept {
+
+                using v_t = typename pack<T, BYTES>::type;
+                constexpr size_t W = BYTES / sizeof(T);
+
+                size_t i = 0;
+                for (; i + W <= n; i += W) {
+
+                    v_t a, b, c, d;
+                    std::memcpy(&a, xr + i, BYTES);
+                    std::memcpy(&b, xi + i, BYTES);
+                    if constexpr (std::is_pointer_v<Y_T>) {
+                        std::memcpy(&c, yr + i, BYTES);
+                        std::memcpy(&d, yi + i, BYTES);
+                    } else {
+                        c = v_t{} + yr;
+                        d = v_t{} + yi;
+                    }
+
+                    const v_t r = a * c - b * d;
+                    const v_t s = a * d + b * c;
+                    std::memcpy(re + i, &r, BYTES);
+                    std::memcpy(im + i, &s, BYTES);
+
+                }
+
+                for (; i < n; ++i) {
+
+                    T c, d;
+                    if constexpr (std::is_pointer_v<Y_T>) {
+                        c = yr[i];
+                        d = yi[i];
+                    } else {
+                        c = yr;
+                        d = yi;
+                    }
+
+                    const T a = xr[i], b = xi[i];
+                    re[i] = a * c - b * d;
+                    im[i] = a * d + b * c;
+
+                }
+
+            }
+
+            /// @brief Squared magnitude kernel on split planes of BYTES wide registers.
+            template <size_t BYTES, typename T>
+            [[gnu::always_inline]] inline void complex_norm_kernel(const T* re, const T* im, T* out, size_t n) noexcept {
+
+                using v_t = typename pack<T, BYTES>::type;
+                constexpr size_t W = BYTES / sizeof(T);
+
+                size_t i = 0;
+                for (; i + W <= n; i += W) {
+
+                    v_t a, b;
+                    std::memcpy(&a, re + i, BYTES);
+                    std::memcpy(&b, im + i, BYTES);
+                    const v_t r = a * a + b * b;
+                    std::memcpy(out + i, &r, BYTES);
+
+                }
+
+                for (; i < n; ++i)
+                    out[i] = re[i] * re[i] + im[i] * im[i];
+
+            }
+
+            /// @brief Recompute by 'std::hypot' the magnitudes whose sum of squares overflowed or fell below the normal numbers.
+            /// @note  Only a magnitude out of [sqrt(min), max] can be spoiled by the squares, so the block is checked by a single pass
+            ///        and the rare elements at the extremes are rescaled.
+            template <typename T>
+            inline void complex_abs_rescale(const T* re, const T* im, T* out, size_t n) noexcept {
+
+                for (size_t i = 0; i < n; ++i)
+                    if (!(out[i] * out[i] >= std::numeric_limits<T>::min() && out[i] <= std::numeric_limits<T>::max()))
+                        out[i] = std::hypot(re[i], im[i]);
+
+            }
+
+            /// @brief Phase of a register of BYTES bytes of complex numbers: the angle atan2(im, re) in (-pi, pi].
+            /// @note  The arctangent of the ratio of the smaller to the larger part is reduced to [0, 0.66]
+            ///        and approximated by the rational function of the Cephes library, then moved to its quadrant
+            ///        by the signs of the parts.
+            template <size_t BYTES, typename T>
+            [[gnu::always_inline]] inline void arg_block(const T* re, const T* im, T* out) noexcept {
+
+                using v_t = typename pack<T, BYTES>::type;
+                using m_t = typename pack<mask_element_t<T>, BYTES>::type;
+
+                v_t x, y;
+                std::memcpy(&x, re, BYTES);
+                std::memcpy(&y, im, BYTES);
+
+                // pi is split into its value in T and the rest of its value in double
+                constexpr T pi = std::numbers::pi_v<T>;
+                constexpr T pi_lo = std::is_same_v<T, float> ? static_cast<T>(std::numbers::pi - static_cast<double>(pi)) : T(1.2246467991473531772e-16);
+                const m_t sign = m_t{} + std::numeric_limits<mask_element_t<T>>::min();
+
+                const m_t x_sign = reinterpret_cast<m_t>(x) & sign;
+                const m_t y_sign = reinterpret_cast<m_t>(y) & sign;
+                const v_t ax = reinterpret_cast<v_t>(reinterpret_cast<m_t>(x) ^ x_sign);
+                const v_t ay = reinterpret_cast<v_t>(reinterpret_cast<m_t>(y) ^ y_sign);
+
+                const auto swap = ay > ax;
+                const v_t hi = swap ? ay : ax;
+                const v_t lo = swap ? ax : ay;
+                v_t t = hi > T(0) ? lo / hi : v_t{};
+
+                const auto reduce = t > T(0.66);
+                t = reduce ? (t - T(1)) / (t + T(1)) : t;
+
+                const v_t z = t * t;
+                const v_t p = (((T(-8.750608600031904122785e-1) * z + T(-1.615753718733365076637e1)) * z +
+                                T(-7.500855792314704667340e1)) * z + T(-1.228866684490136173410e2)) * z + T(-6.485021904942025371773e1);
+                const v_t q = ((((z + T(2.485846490142306297962e1)) * z + T(1.650270098316988542046e2)) * z +
+                                T(4.328810604912902668951e2)) * z + T(4.853903996359136964868e2)) * z + T(1.945506571482613964425e2);
+
+                v_t a = t + t * (z * p / q);
+                a = reduce ? pi / 4 + (a + pi_lo / 4) : a;
+                a = swap ? (pi / 2 - a) + pi_lo / 2 : a;
+                a = x_sign != 0 ? (pi - a) + pi_lo : a;
+
+                const v_t r = reinterpret_cast<v_t>(reinterpret_cast<m_t>(a) | y_sign);
+                std::memcpy(out, &r, BYTES);
+
+            }
+
+            /// @brief Phase kernel on split planes of BYTES wide registers.
+            /// @note  The tail is padded to a full register, so that every element is computed by the same instructions whatever its position.
+            template <size_t BYTES, typename T>
+            [[gnu::always_inline]] inline void complex_arg_kernel(const T* re, const T* im, T* out, size_t n) noexcept {
+
+                constexpr size_t W = BYTES / sizeof(T);
+
+                size_t i = 0;
+                for (; i + W <= n; i += W)
+                    arg_block<BYTES>(re + i, im + i, out + i);
+
+                if (i < n) {
+
+                    std::array<T, W> x{}, y{}, r;
+                    std::copy(re + i, re + n, x.begin());
+                    std::copy(im + i, im + n, y.begin());
+                    arg_block<BYTES>(x.data(), y.data(), r.data());
+                    std::copy(r.begin(), r.begin() + (n - i), out + i);
+
+                }
+
+            }
+
+
+            #if CTDA_SIMD_X86
+
+                template <op OP, typename T, typename X_T, typename Y_T>
+                [[gnu::target("avx512f")]] void binary_avx512(const X_T x, const Y_T y, T* out, size_t n) noexcept {
+                    binary_kernel<OP, 64>(x, y, out, n);
+                }
+
+                template <op OP, typename T, typename X_T, typename Y_T>
+                [[gnu::target("avx2")]] void binary_avx2(const X_T x, const Y_T y, T* out, size_t n) noexcept {
+                    binary_kernel<OP, 32>(x, y, out, n);
+                }
+
+
+                template <typename T>
+                [[gnu::target("avx512f")]] std::pair<T, T> moments_avx512(const T* x, size_t n, T shift) noexcept {
+                    return moments_kernel<64>(x, n, shift);
+                }
+
+                template <typename T>
+                [[gnu::target("avx2")]] std::pair<T, T> moments_avx2(const T* x, size_t n, T shift) noexcept {
+                    return moments_kernel<32>(x, n, shift);
+                }
+
+
+                template <typename T>
+                [[gnu::target("avx512f")]] T dot_avx512(const T* x, const T* y, size_t n) noexcept {
+                    return dot_kernel<64>(x, y, n);
+                }
+
+                // the AVX2 tier is selected only if FMA is supported as well
+                template <typename T>
+                [[gnu::target("avx2,fma")]] T dot_avx2(const T* x, const T* y, size_t n) noexcept {
+                    return dot_kernel<32>(x, y, n);
+                }
+
+                template <typename T>
+                [[gnu::target("avx512f")]] void gemm_avx512(size_t m, size_t n, size_t k, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc) {
+                    gemm_kernel<64>(m, n, k, a, lda, b, ldb, c, ldc);
+                }
+
+                template <typename T>
+                [[gnu::target("avx2,fma")]] void gemm_avx2(size_t m, size_t n, size_t k, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc) {
+                    gemm_kernel<32>(m, n, k, a, lda, b, ldb, c, ldc);
+                }
+
+
+                template <typename S, typename D>
+                [[gnu::target("avx512f")]] void widen_avx512(const S* x, D* out, size_t n) noexcept {
+
+                    if constexpr (std::is_same_v<S, float16_t>) {
+                        size_t i = 0;
+                        for (; i + 16 <= n; i += 16)
+                            store_widened<64>(_mm512_maskz_cvtph_ps(__mmask16(-1), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i))), out + i);
+                        for (; i < n; ++i)
+                            out[i] = static_cast<D>(x[i]);
+                        return;
+                    }
+                    widen_kernel<64>(x, out, n);
+
+                }
+
+                // the AVX2 tier is selected only if F16C is supported as well
+                template <typename S, typename D>
+                [[gnu::target("avx2,f16c")]] void widen_avx2(const S* x, D* out, size_t n) noexcept {
+
+                    if constexpr (std::is_same_v<S, float16_t>) {
+                        size_t i = 0;
+                        for (; i + 8 <= n; i += 8)
+                            store_widened<32>(_mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i))), out + i);
+                        for (; i < n; ++i)
+                            out[i] = static_cast<D>(x[i]);
+                        return;
+                    }
+                    widen_kernel<32>(x, out, n);
+
+                }
+
+                template <typename S>
+                [[gnu::target("avx512f")]] void narrow_avx512(const float* x, S* out, size_t n) noexcept {
+
+                    if constexpr (std::is_same_v<S, float16_t>) {
+                        size_t i = 0;
+                        for (; i + 16 <= n; i += 16)
+                            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm512_maskz_cvtps_ph(__mmask16(-1), _mm512_loadu_ps(x + i), _MM_FROUND_TO_NEAREST_INT));
+                        for (; i < n; ++i)
+                            out[i] = static_cast<S>(x[i]);
+                        return;
+                    }
+                    narrow_kernel<64>(x, out, n);
+
+                }
+
+                template <typename S>
+                [[gnu::target("avx2,f16c")]] void narrow_avx2(const float* x, S* out, size_t n) noexcept {
+
+                    if constexpr (std::is_same_v<S, float16_t>) {
+                        size_t i = 0;
+                        for (; i + 8 <= n; i += 8)
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(x + i), _MM_FROUND_TO_NEAREST_INT));
+                        for (; i < n; ++i)
+                            out[i] = static_cast<S>(x[i]);
+                        return;
+                    }
+                    narrow_kernel<32>(x, out, n);
+
+                }
+
+
+                [[gnu::target("avx512f")]] inline void philox_avx512(const std::array<uint32_t, 2>& key, const std::array<uint32_t, 4>& counter, uint32_t* out, size_t blocks) noexcept {
+                    philox_kernel<64>(key, counter, out, blocks);
+                }
+
+                [[gnu::target("avx2")]] inline void philox_avx2(const std::array<uint32_t, 2>& key, const std::array<uint32_t, 4>& counter, uint32_t* out, size_t blocks) noexcept {
+                    philox_kernel<32>(key, counter, out, blocks);
+                }
+
+
+                template <op OP, int POWER, typename T>
+                [[gnu::target("avx512f")]] void unary_avx512(const T* x, T* out, size_t n) noexcept {
+
+                    if constexpr (OP == op::root) {
+
+                        static_assert(has_root_kernel_v<POWER>, "The root kernels chain square roots, the index must be a power of two");
+
+                        constexpr size_t W = 64 / sizeof(T);
+                        size_t i = 0;
+                        for (; i + W <= n; i += W)
+                            if constexpr (std::is_same_v<T, double>) {
+                                __m512d r = _mm512_loadu_pd(x + i);
+                                for (int k = 1; k < (POWER < 0 ? -POWER : POWER); k *= 2)
+                                    r = _mm512_maskz_sqrt_pd(__mmask8(-1), r);
+                                if constexpr (POWER < 0)
+                                    r = _mm512_div_pd(_mm512_set1_pd(1.0), r);
+                                _mm512_storeu_pd(out + i, r);
+                            } else {
+                                __m512 r = _mm512_loadu_ps(x + i);
+                                for (int k = 1; k < (POWER < 0 ? -POWER : POWER); k *= 2)
+                                    r = _mm512_maskz_sqrt_ps(__mmask16(-1), r);
+                                if constexpr (POWER < 0)
+                                    r = _mm512_div_ps(_mm512_set1_ps(1.0f), r);
+                                _mm512_storeu_ps(out + i, r);
+                            }
+                        for (; i < n; ++i) {
+                            out[i] = x[i];
+                            extract<POWER>(out[i]);
+                        }
+
+                    } else
+                        unary_kernel<OP, POWER, 64>(x, out, n);
+
+                }
+
+                template <op OP, int POWER, typename T>
+                [[gnu::target("avx2")]] void unary_avx2(const T* x, T* out, size_t n) noexcept {
+
+                    if constexpr (OP == op::root) {
+
+                        static_assert(has_root_kernel_v<POWER>, "The root kernels chain square roots, the index must be a power of two");
+
+                        constexpr size_t W = 32 / sizeof(T);
+                        size_t i = 0;
+                        for (; i + W <= n; i += W)
+                            if constexpr (std::is_same_v<T, double>) {
+                                __m256d r = _mm256_loadu_pd(x + i);
+                                for (int k = 1; k < (POWER < 0 ? -POWER : POWER); k *= 2)
+                                    r = _mm256_sqrt_pd(r);
+                                if constexpr (POWER < 0)
+                                    r = _mm256_div_pd(_mm256_set1_pd(1.0), r);
+                                _mm256_storeu_pd(out + i, r);
+                            } else {
+                                __m256 r = _mm256_loadu_ps(x + i);
+                                for (int k = 1; k < (POWER < 0 ? -POWER : POWER); k *= 2)
+                                    r = _mm256_sqrt_ps(r);
+                                if constexpr (POWER < 0)
+                                    r = _mm256_div_ps(_mm256_set1_ps(1.0f), r);
+                                _mm256_storeu_ps(out + i, r);
+                            }
+                        for (; i < n; ++i) {
+                            out[i] = x[i];
+                            extract<POWER>(out[i]);
+                        }
+
+                    } else
+                        unary_kernel<OP, POWER, 32>(x, out, n);
+
+                }
+
+                template <op OP, int POWER, typename T>
+                void unary_sse2(const T* x, T* out, size_t n) noexcept {
+
+                    if constexpr (OP == op::root) {
+
+                        static_assert(has_root_kernel_v<POWER>, "The root kernels chain square roots, the index must be a power of two");
+
+                        constexpr size_t W = 16 / sizeof(T);
+                        size_t i = 0;
+                        for (; i + W <= n; i += W)
+                            if constexpr (std::is_same_v<T, double>) {
+                                __m128d r = _mm_loadu_pd(x + i);
+                                for (int k = 1; k < (POWER < 0 ? -POWER : POWER); k *= 2)
+                                    r = _mm_sqrt_pd(r);
+                                if constexpr (POWER < 0)
+                                    r = _mm_div_pd(_mm_set1_pd(1.0), r);
+                                _mm_storeu_pd(out + i, r);
+                            } else {
+                                __m128 r = _mm_loadu_ps(x + i);
+                                for (int k = 1; k < (POWER < 0 ? -POWER : POWER); k *= 2)
+                                    r = _mm_sqrt_ps(r);
+                                if constexpr (POWER < 0)
+                                    r = _mm_div_ps(_mm_set1_ps(1.0f), r);
+                                _mm_storeu_ps(out + i, r);
+                            }
+                        for (; i < n; ++i) {
+                            out[i] = x[i];
+                            extract<POWER>(out[i]);
+                        }
+
+                    } else
+                        unary_kernel<OP, POWER, 16>(x, out, n);
+
+                }
+
+
+                /// @brief Number of elements of the blocks of 'complex_abs', small enough to stay in the L1 cache between its two passes.
+                inline constexpr size_t complex_block = 1024;
+
+                template <typename T>
+                [[gnu::target("avx512f")]] void deinterleave_avx512(const T* z, T* re, T* im, size_t n) noexcept {
+                    deinterleave_kernel<64>(z, re, im, n);
+                }
+
+                template <typename T>
+                [[gnu::target("avx2")]] void deinterleave_avx2(const T* z, T* re, T* im, size_t n) noexcept {
+                    deinterleave_kernel<32>(z, re, im, n);
+                }
+
+                template <typename T>
+                [[gnu::target("avx512f")]] void interleave_avx512(const T* re, const T* im, T* z, size_t n) noexcept {
+                    interleave_kernel<64>(re, im, z, n);
+                }
+
+                template <typename T>
+                [[gnu::target("avx2")]] void interleave_avx2(const T* re, const T* im, T* z, size_t n) noexcept {
+                    interleave_kernel<32>(re, im, z, n);
+                }
+
+                template <typename T, typename Y_T>
+                [[gnu::target("avx512f")]] void complex_mult_avx512(const T* xr, const T* xi, const Y_T yr, const Y_T yi, T* re, T* im, size_t n) noexcept {
+                    complex_mult_kernel<64>(xr, xi, yr, yi, re, im, n);
+                }
+
+                template <typename T, typename Y_T>
+                [[gnu::target("avx2")]] void complex_mult_avx2(const T* xr, const T* xi, const Y_T yr, const Y_T yi, T* re, T* im, size_t n) noexcept {
+                    complex_mult_kernel<32>(xr, xi, yr, yi, re, im, n);
+                }
+
+                template <typename T>
+                [[gnu::target("avx512f")]] void complex_abs_avx512(const T* re, const T* im, T* out, size_t n) noexcept {
+
+                    for (size_t i = 0; i < n; i += complex_block) {
+                        const size_t len = std::min(complex_block, n - i);
+                        complex_norm_kernel<64>(re + i, im + i, out + i, len);
+                        unary_avx512<op::root, 2>(out + i, out + i, len);
+                        complex_abs_rescale(re + i, im + i, out + i, len);
+                    }
+
+                }
+
+                template <typename T>
+                [[gnu::target("avx2")]] void complex_abs_avx2(const T* re, const T* im, T* out, size_t n) noexcept {
+
+                    for (size_t i = 0; i < n; i += complex_block) {
+                        const size_t len = std::min(complex_block, n - i);
+                        complex_norm_kernel<32>(re + i, im + i, out + i, len);
+                        unary_avx2<op::root, 2>(out + i, out + i, len);
+                        complex_abs_rescale(re + i, im + i, out + i, len);
+                    }
+
+                }
+
+                template <typename T>
+                void complex_abs_sse2(const T* re, const T* im, T* out, size_t n) noexcept {
+
+                    for (size_t i = 0; i < n; i += complex_block) {
+                        const size_t len = std::min(complex_block, n - i);
+                        complex_norm_kernel<16>(re + i, im + i, out + i, len);
+                        unary_sse2<op::root, 2>(out + i, out + i, len);
+                        complex_abs_rescale(re + i, im + i, out + i, len);
+                    }
+
+                }
+
+                template <typename T>
+                [[gnu::target("avx512f")]] void complex_arg_avx512(const T* re, const T* im, T* out, size_t n) noexcept {
+                    complex_arg_kernel<64>(re, im, out, n);
+                }
+
+                template <typename T>
+                [[gnu::target("avx2")]] void complex_arg_avx2(const T* re, const T* im, T* out, size_t n) noexcept {
+                    complex_arg_kernel<32>(re, im, out, n);
+                }
+
+            #endif
+
+
+            /// @brief Apply a binary operation element-wise, dispatching on the available instruction set.
+            /// @note  Each operand is either a pointer to n elements or a scalar broadcasted to all of them.
+            template <op OP, typename T, typename X_T, typename Y_T>
+            inline void binary(const X_T x, const Y_T y, T* out, size_t n) noexcept {
+
+                #if CTDA_SIMD_X86
+                    switch (level()) {
+                        case isa::avx512: return binary_avx512<OP>(x, y, out, n);
+                        case isa::avx2:   return binary_avx2<OP>(x, y, out, n);
+                        default:          return binary_kernel<OP, 16>(x, y, out, n);
+                    }
+                #else
+                    binary_kernel<OP, sizeof(T)>(x, y, out, n);
+                #endif
+
+            }
+
+            /// @brief Apply an unary operation element-wise, dispatching on the available instruction set.
+            template <op OP, int POWER = 1, typename T>
+            inline void unary(const T* x, T* out, size_t n) noexcept {
+
+                #if CTDA_SIMD_X86
+                    switch (level()) {
+                        case isa::avx512: return unary_avx512<OP, POWER>(x, out, n);
+                        case isa::avx2:   return unary_avx2<OP, POWER>(x, out, n);
+                        default:          return unary_sse2<OP, POWER>(x, out, n);
+                    }
+                #else
+                    if constexpr (OP == op::root)
+                        for (size_t i = 0; i < n; ++i) {
+                            out[i] = x[i];
+                            extract<POWER>(out[i]);
+                        }
+                    else
+                        unary_kernel<OP, POWER, sizeof(T)>(x, out, n);
+                #endif
+
+            }
+
+
+            /// @brief Compute the sum and the sum of squares of the deviations of n elements from 'shift',
+            ///        dispatching on the available instruction set.
+            template <typename T>
+            inline std::pair<T, T> moments(const T* x, size_t n, T shift) noexcept {
+
+                #if CTDA_SIMD_X86
+                    switch (level()) {
+                        case isa::avx512: return moments_avx512(x, n, shift);
+                        case isa::avx2:   return moments_avx2(x, n, shift);
+                        default:          return moments_kernel<16>(x, n, shift);
+                    }
+                #else
+                    return moments_kernel<sizeof(T)>(x, n, shift);
+                #endif
+
+            }
+
+
+            /// @brief Compute the dot product of n elements, dispatching on the available instruction set.
+            template <typename T>
+            inline T dot(const T* x, const T* y, size_t n) noexcept {
+
+                #if CTDA_SIMD_X86
+                    switch (level()) {
+                        case isa::avx512: return dot_avx512(x, y, n);
+                        case isa::avx2:   return dot_avx2(x, y, n);
+                        default:          return dot_kernel<16>(x, y, n);
+                    }
+                #else
+                    return dot_kernel<sizeof(T)>(x, y, n);
+                #endif
+
+            }
+
+            /// @brief Compute the matrix product c = a b of row-major matrices, dispatching on the available instruction set.
+            template <typename T>
+            inline void gemm(size_t m, size_t n, size_t k, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc) {
+
+                #if CTDA_SIMD_X86
+                    switch (level()) {
+                        case isa::avx512: return gemm_avx512(m, n, k, a, lda, b, ldb, c, ldc);
+                        case isa::avx2:   return gemm_avx2(m, n, k, a, lda, b, ldb, c, ldc);
+                        default:          return gemm_kernel<16>(m, n, k, a, lda, b, ldb, c, ldc);
+                    }
+                #else
+                    gemm_kernel<sizeof(T)>(m, n, k, a, lda, b, ldb, c, ldc);
+                #endif
+
+            }
+
+
+            /// @brief Convert n elements stored as S into the compute type D (float or double),
+            ///        dispatching on the available instruction set.
+            template <typename S, typename D>
+            inline void widen(const S* x, D* out, size_t n) noexcept {
+
+                #if CTDA_SIMD_X86
+                    switch (level()) {
+                        case isa::avx512: return widen_avx512(x, out, n);
+                        case isa::avx2:   return widen_avx2(x, out, n);
+                        default:          return widen_kernel<16>(x, out, n);
+                    }
+                #else
+                    widen_kernel<sizeof(float)>(x, out, n);
+                #endif
+
+            }
+
+            /// @brief Convert n floats into the storage type S, dispatching on the available instruction set.
+            template <typename S>
+            inline void narrow(const float* x, S* out, size_t n) noexcept {
+
+                #if CTDA_SIMD_X86
+                    switch (level()) {
+                        case isa::avx512: return narrow_avx512(x, out, n);
+                        case isa::avx2:   return narrow_avx2(x, out, n);
+                        default:          return narrow_kernel<16>(x, out, n);
+                    }
+                #else
+                    narrow_kernel<sizeof(float)>(x, out, n);
+                #endif
+
+            }
+
+
+            /// @brief Draw 'blocks' blocks of 64 words from the Philox4x32-10 generator, dispatching on the available instruction set.
+            inline void philox(const std::array<uint32_t, 2>& key, const std::array<uint32_t, 4>& counter, uint32_t* out, size_t blocks) noexcept {
+
+                #if CTDA_SIMD_X86
+                    switch (level()) {
+                        case isa::avx512: return philox_avx512(key, counter, out, blocks);
+                        case isa::avx2:   return philox_avx2(key, counter, out, blocks);
+                        default:          return philox_kernel<16>(key, counter, out, blocks);
+                    }
+                #else
+                    philox_kernel<sizeof(uint32_t)>(key, counter, out, blocks);
+                #endif
+
+            }
+
+
+            /// @brief Split n interleaved complex numbers into their planes, dispatching on the available instruction set.
+            template <typename T>
+            inline void deinterleave(const T* z, T* re, T* im, size_t n) noexcept {
+
+                #if CTDA_SIMD_X86
+                    switch (level()) {
+                        case isa::avx512: return deinterleave_avx512(z, re, im, n);
+                        case isa::avx2:   return deinterleave_avx2(z, re, im, n);
+                        default:          return deinterleave_kernel<16>(z, re, im, n);
+                    }
+                #else
+                    deinterleave_kernel<sizeof(T)>(z, re, im, n);
+                #endif
+
+            }
+
+            /// @brief Merge two planes into n interleaved complex numbers, dispatching on the available instruction set.
+            template <typename T>
+            inline void interleave(const T* re, const T* im, T* z, size_t n) noexcept {
+
+                #if CTDA_SIMD_X86
+                    switch (level()) {
+                        case isa::avx512: return interleave_avx512(re, im, z, n);
+                        case isa::avx2:   return interleave_avx2(re, im, z, n);
+                        default:          return interleave_kernel<16>(re, im, z, n);
+                    }
+                #else
+                    interleave_kernel<sizeof(T)>(re, im, z, n);
+                #endif
+
+            }
+
+            /// @brief Multiply n complex numbers stored in split planes, dispatching on the available instruction set.
+            /// @note  The planes of y are pointers to n elements, or the parts of a complex number broadcasted to all of them.
+            template <typename T, typename Y_T>
+            inline void complex_mult(const T* xr, const T* xi, const Y_T yr, const Y_T yi, T* re, T* im, size_t n) noexcept {
+
+                #if CTDA_SIMD_X86
+                    switch (level()) {
+                        case isa::avx512: return complex_mult_avx512(xr, xi, yr, yi, re, im, n);
+                        case isa::avx2:   return complex_mult_avx2(xr, xi, yr, yi, re, im, n);
+                        default:          return complex_mult_kernel<16>(xr, xi, yr, yi, re, im, n);
+                    }
+                #else
+                    complex_mult_kernel<sizeof(T)>(xr, xi, yr, yi, re, im, n);
+                #endif
+
+            }
+
+            /// @brief Compute the magnitudes of n complex numbers stored in split planes, dispatching on the available instruction set.
+            /// @note  The squares of the parts are summed directly, and the magnitudes at the extremes are recomputed by 'std::hypot'.
+            template <typename T>
+            inline void complex_abs(const T* re, const T* im, T* out, size_t n) noexcept {
+
+                #if CTDA_SIMD_X86
+                    switch (level()) {
+                        case isa::avx512: return complex_abs_avx512(re, im, out, n);
+                        case isa::avx2:   return complex_abs_avx2(re, im, out, n);
+                        default:          return complex_abs_sse2(re, im, out, n);
+                    }
+                #else
+                    for (size_t i = 0; i < n; ++i)
+                        out[i] = std::sqrt(re[i] * re[i] + im[i] * im[i]);
+                    complex_abs_rescale(re, im, out, n);
+                #endif
+
+            }
+
+            /// @brief Compute the phases of n complex numbers stored in split planes, dispatching on the available instruction set.
+            template <typename T>
+            inline void complex_arg(const T* re, const T* im, T* out, size_t n) noexcept {
+
+                #if CTDA_SIMD_X86
+                    switch (level()) {
+                        case isa::avx512: return complex_arg_avx512(re, im, out, n);
+                        case isa::avx2:   return complex_arg_avx2(re, im, out, n);
+                        default:          return complex_arg_kernel<16>(re, im, out, n);
+                    }
+                #else
+                    complex_arg_kernel<sizeof(T)>(re, im, out, n);
+                #endif
+
+            }
+
+
+        } // namespace simd
+
+
+    } // namespace math
+
+
+} // namespace ctda
+
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,189 @@
+/**
+ * @file    math/statistics.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the implementation of the streaming 'accumulator' struct.
+ * @date    2023-11-17
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    namespace math {
+
+
+        /// @brief This template meta-struct accumulates a stream of samples of a quantity into its mean and its standard error.
+        /// @note  The samples are not stored: the count, the mean and the sum of the squared deviations are updated
+        ///        online with the Welford algorithm, and batches and partial accumulators are merged with the Chan formula.
+        ///        Samples stored as floats or in reduced precision are accumulated in double.
+        /// @tparam QUANTITY_T: the quantity sampled, with a floating point value
+        template <typename QUANTITY_T>
+            requires (is_quantity_v<QUANTITY_T> && std::is_floating_point_v<compute_t<typename QUANTITY_T::value_t>>)
+        struct accumulator {
+
+
+            using value_t = accumulate_t<typename QUANTITY_T::value_t>;
+
+            using unit_t = typename QUANTITY_T::unit_t;
+
+            using quantity_t = quantity<value_t, unit_t>;
+
+            using measurement_t = measurement<quantity_t>;
+
+
+            size_t n = 0;               //< number of samples
+
+            value_t mu = 0;             //< mean of the samples
+
+            value_t m2 = 0;             //< sum of the squared deviations from the mean
+
+
+            /// @brief Add a sample, converted to the unit of the accumulator.
+            template <typename T>
+                requires (are_same_quantity_v<T, QUANTITY_T> && std::is_arithmetic_v<compute_t<typename T::value_t>>)
+            constexpr void push(const T& x) noexcept {
+
+                const value_t v = scale<conversion_t<typename T::unit_t, unit_t>>(static_cast<value_t>(x.value));
+                const value_t delta = v - this->mu;
+                this->mu += delta / static_cast<value_t>(++this->n);
+                this->m2 += delta * (v - this->mu);
+
+            }
+
+            /// @brief Add a batch of samples stored contiguously, reduced with the SIMD kernels.
+            /// @note  Samples stored in a narrower type are widened by blocks on the stack.
+            template <typename T>
+                requires (are_same_quantity_v<T, QUANTITY_T> && std::ranges::contiguous_range<typename T::value_t> &&
+                          std::is_same_v<accumulate_t<std::ranges::range_value_t<typename T::value_t>>, value_t>)
+            void push(const T& x) noexcept {
+
+                using element_t = std::ranges::range_value_t<typename T::value_t>;
+
+                const size_t count = std::ranges::size(x.value);
+                if (count == 0)
+                    return;
+
+                using ratio_t = conversion_t<unit_t, typename T::unit_t>;
+                const element_t* data = std::ranges::data(x.value);
+                const value_t shift = this->n ? scale<ratio_t>(this->mu) : static_cast<value_t>(data[0]);
+
+                value_t sum{}, sum_sq{};
+                if constexpr (CTDA_USE_SIMD && simd::is_vectorizable_v<value_t> && std::is_same_v<element_t, value_t>)
+                    std::tie(sum, sum_sq) = simd::moments(data, count, shift);
+                else if constexpr (CTDA_USE_SIMD && simd::is_vectorizable_v<value_t>) {
+                    constexpr size_t block_size = 256;
+                    std::array<value_t, block_size> buffer;
+                    for (size_t i = 0; i < count; i += block_size) {
+                        const size_t len = std::min(block_size, count - i);
+                        simd::widen(data + i, buffer.data(), len);
+                        const auto [s1, s2] = simd::moments(buffer.data(), len, shift);
+                        sum += s1;
+                        sum_sq += s2;
+                    }
+                }
+                else
+                    for (size_t i = 0; i < count; ++i) {
+                        const value_t d = static_cast<value_t>(data[i]) - shift;
+                        sum += d;
+                        sum_sq += d * d;
+                    }
+
+                using inverse_t = conversion_t<typename T::unit_t, unit_t>;
+                const value_t mean = shift + sum / static_cast<value_t>(count);
+                const value_t m2 = std::max(value_t(0), sum_sq - sum * sum / static_cast<value_t>(count));
+                this->merge(count, scale<inverse_t>(mean), scale<inverse_t>(scale<inverse_t>(m2)));
+
+            }
+
+            /// @brief Merge the partial accumulator of another stream of the same quantity, for example from another thread.
+            template <typename T>
+                requires (are_same_quantity_v<T, QUANTITY_T>)
+            constexpr void merge(const accumulator<T>& other) noexcept {
+
+                using ratio_t = conversion_t<typename T::unit_t, unit_t>;
+                this->merge(other.n, scale<ratio_t>(static_cast<value_t>(other.mu)), scale<ratio_t>(scale<ratio_t>(static_cast<value_t>(other.m2))));
+
+            }
+
+
+            /// @brief Get the number of samples.
+            constexpr size_t count() const noexcept {
+
+                return this->n;
+
+            }
+
+            /// @brief Get the mean of the samples.
+            constexpr quantity_t mean() const noexcept {
+
+                return this->mu;
+
+            }
+
+            /// @brief Get the unbiased variance of the samples.
+            constexpr quantity<value_t, square_t<unit_t>> variance() const noexcept {
+
+                return this->n > 1 ? this->m2 / static_cast<value_t>(this->n - 1) : value_t(0);
+
+            }
+
+            /// @brief Get the standard deviation of the samples.
+            constexpr quantity_t stddev() const noexcept {
+
+                return std::sqrt(this->variance().value);
+
+            }
+
+            /// @brief Get the standard error of the mean.
+            constexpr quantity_t error() const noexcept {
+
+                return this->n > 1 ? std::sqrt(this->variance().value / static_cast<value_t>(this->n)) : value_t(0);
+
+            }
+
+
+            /// @brief Get the mean of the samples with its standard error.
+            constexpr measurement_t estimate() const noexcept {
+
+                return {this->mean(), this->error()};
+
+            }
+
+            constexpr operator measurement_t() const noexcept {
+
+                return this->estimate();
+
+            }
+
+
+          private:
+
+
+            /// @brief Merge the count, the mean and the sum of the squared deviations of a set of samples.
+            constexpr void merge(size_t count, value_t mean, value_t m2) noexcept {
+
+                if (count == 0)
+                    return;
+
+                const size_t total = this->n + count;
+                const value_t delta = mean - this->mu;
+                const value_t weight = static_cast<value_t>(count) / static_cast<value_t>(total);
+
+                this->mu += delta * weight;
+                this->m2 += m2 + delta * delta * static_cast<value_t>(this->n) * weight;
+                this->n = total;
+
+            }
+
+
+        }; // struct accumulator
+
+
+    } // namespace math
+
+
+} // namespace ctda
@@ -0,0 +1,150 @@
+/**
+ * @file    memory.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the per-thread 'arena' and the allocator helpers of the containers.
+ * @date    2023-11-16
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    namespace memory {
+
+
+        /// @brief Get the memory resource of the calling thread: the innermost active arena, or the default resource.
+        inline std::pmr::memory_resource* resource() noexcept;
+
+
+        /// @brief This struct is a monotonic arena serving the polymorphic containers created by the calling thread.
+        /// @note  While an arena is alive, the containers with a polymorphic allocator created by the operations
+        ///        draw their memory from a bump allocator, which is released all at once by the destructor.
+        ///        The containers must not outlive the arena. Arenas can be nested, each one growing from the outer one.
+        struct arena {
+
+
+            /// @brief Constructor, installs the arena as the memory resource of the calling thread.
+            /// @param bytes: The size of the first buffer of the arena.
+            explicit arena(size_t bytes = 1 << 16) : buffer{bytes, memory::resource()}, previous{current()} {
+
+                current() = &this->buffer;
+
+            }
+
+            arena(const arena&) = delete;
+
+            arena& operator=(const arena&) = delete;
+
+            /// @brief Destructor, restores the previous memory resource of the calling thread.
+            ~arena() noexcept {
+
+                current() = this->previous;
+
+            }
+
+
+            /// @brief Get the memory resource of the arena.
+            std::pmr::memory_resource* resource() noexcept {
+
+                return &this->buffer;
+
+            }
+
+            /// @brief Release all the memory of the arena, to be reused by the next batch of temporaries.
+            void release() noexcept {
+
+                this->buffer.release();
+
+            }
+
+
+            friend std::pmr::memory_resource* memory::resource() noexcept;
+
+
+          private:
+
+
+            /// @brief Get the innermost arena of the calling thread.
+            static std::pmr::memory_resource*& current() noexcept {
+
+                thread_local std::pmr::memory_resource* resource = nullptr;
+                return resource;
+
+            }
+
+
+            std::pmr::monotonic_buffer_resource buffer;
+
+            std::pmr::memory_resource* previous;
+
+
+        }; // struct arena
+
+
+        inline std::pmr::memory_resource* resource() noexcept {
+
+            std::pmr::memory_resource* current = arena::current();
+            return current ? current : std::pmr::get_default_resource();
+
+        }
+
+
+        /// @brief This template meta-struct checks if a type is a polymorphic allocator.
+        template <typename T>
+        struct is_polymorphic_allocator : std::false_type {};
+
+        template <typename T>
+        struct is_polymorphic_allocator<std::pmr::polymorphic_allocator<T>> : std::true_type {};
+
+        template <typename T>
+        inline constexpr bool is_polymorphic_allocator_v = is_polymorphic_allocator<T>::value;
+
+
+        template <typename ALLOC_T, typename T>
+        using rebind_alloc_t = typename std::allocator_traits<ALLOC_T>::template rebind_alloc<T>;
+
+        /// @brief Get the allocator of a new container of T derived from a container using 'alloc'.
+        /// @note  Polymorphic allocators draw from the memory resource of the calling thread,
+        ///        the other allocators are copied as for the copy construction of their container.
+        template <typename T, typename ALLOC_T>
+        constexpr rebind_alloc_t<ALLOC_T, T> rebind_allocator(const ALLOC_T& alloc) noexcept {
+
+            if constexpr (is_polymorphic_allocator_v<ALLOC_T>)
+                return resource();
+            else
+                return rebind_alloc_t<ALLOC_T, T>(std::allocator_traits<ALLOC_T>::select_on_container_copy_construction(alloc));
+
+        }
+
+
+        /// @brief Create an empty container storing the result of an operation on 'source'.
+        /// @note  The allocator is obtained from the one of 'source' when it is compatible.
+        template <typename CONTAINER_T, typename SOURCE_T>
+        constexpr CONTAINER_T make_container(const SOURCE_T& source) {
+
+            if constexpr (requires { typename CONTAINER_T::allocator_type; }) {
+
+                using alloc_t = typename CONTAINER_T::allocator_type;
+
+                if constexpr (is_polymorphic_allocator_v<alloc_t>)
+                    return CONTAINER_T(alloc_t(resource()));
+                else if constexpr (requires { alloc_t(rebind_allocator<typename alloc_t::value_type>(source.get_allocator())); })
+                    return CONTAINER_T(alloc_t(rebind_allocator<typename alloc_t::value_type>(source.get_allocator())));
+                else
+                    return CONTAINER_T{};
+
+            }
+            else
+                return CONTAINER_T{};
+
+        }
+
+
+    } // namespace memory
+
+
+} // namespace ctda
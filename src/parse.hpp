@@ -0,0 +1,387 @@
+/**
+ * @file    parse.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the 'from_chars' parsers of quantities and measurements and the bulk column parser.
+ * @date    2023-11-21
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    /// @brief Read an integer which spans the whole text.
+    template <typename T>
+    bool read_integer(std::string_view text, T& x) noexcept {
+
+        const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), x);
+        return ec == std::errc{} && ptr == text.data() + text.size() && !text.empty();
+
+    }
+
+
+    /// @brief Read the label of a unit, like "(k)m s^-1": the powers of its base, powers[i] / power_den reduced, and its prefix, num / den * 10^e.
+    /// @note  The prefix is optional and written in brackets, as a symbol, as "1eN" or as a ratio "num/den",
+    ///        and a power is an integer or a ratio, as in "Hz^-1/2".
+    /// @return 'invalid_argument' if the label is malformed, 'result_out_of_range' if the denominator of the powers exceeds 256.
+    inline std::errc read_unit_label(std::string_view text, std::array<int, 7>& powers, int& power_den, intmax_t& num, intmax_t& den, int& e) noexcept {
+
+        powers = {};
+        power_den = 1;
+        num = 1;
+        den = 1;
+        e = 0;
+
+        if (text.starts_with('(')) {
+
+            const size_t close = text.find(')');
+            if (close == std::string_view::npos)
+                return std::errc::invalid_argument;
+
+            const std::string_view prefix = text.substr(1, close - 1);
+            text.remove_prefix(close + 1);
+
+            const auto symbol = std::ranges::find(prefix_symbols, prefix.size() == 1 ? prefix[0] : '\0', &std::pair<int, char>::second);
+            if (symbol != prefix_symbols.end())
+                e = symbol->first;
+            else if (prefix.starts_with("1e")) {
+                if (!read_integer(prefix.substr(2), e))
+                    return std::errc::invalid_argument;
+            }
+            else {
+                const size_t slash = prefix.find('/');
+                if (!read_integer(prefix.substr(0, slash), num) ||
+                    (slash != std::string_view::npos && !read_integer(prefix.substr(slash + 1), den)) || num <= 0 || den <= 0)
+                    return std::errc::invalid_argument;
+            }
+
+        }
+
+        while (!text.empty()) {
+
+            const size_t end = text.find(' ');
+            std::string_view term = text.substr(0, end);
+            text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+            if (term.empty())
+                continue;
+
+            int power = 1, root = 1;
+            const size_t caret = term.find('^');
+            if (caret != std::string_view::npos) {
+                const std::string_view exponent = term.substr(caret + 1);
+                const size_t slash = exponent.find('/');
+                if (!read_integer(exponent.substr(0, slash), power) ||
+                    (slash != std::string_view::npos && !read_integer(exponent.substr(slash + 1), root)) || root <= 0)
+                    return std::errc::invalid_argument;
+                term = term.substr(0, caret);
+            }
+
+            const auto literal = std::ranges::find(base_unit_literals, term);
+            if (literal == base_unit_literals.end())
+                return std::errc::invalid_argument;
+
+            if (root > 256)
+                return std::errc::result_out_of_range;
+            if (const int common = std::lcm(power_den, root); common != power_den) {
+                if (common > 256)
+                    return std::errc::result_out_of_range;
+                for (int& p : powers)
+                    p *= common / power_den;
+                power_den = common;
+            }
+            powers[static_cast<size_t>(literal - base_unit_literals.begin())] += power * (power_den / root);
+
+        }
+
+        int g = power_den;
+        for (int p : powers)
+            g = std::gcd(g, p);
+        for (int& p : powers)
+            p /= g;
+        power_den /= g;
+
+        return std::errc{};
+
+    }
+
+
+    /// @brief Label of a unit read from text, with the factor that rescales its values into UNIT_T.
+    /// @note  The same label is usually repeated on every line of a column,
+    ///        so the last one parsed is kept and compared before parsing the next.
+    template <typename UNIT_T>
+        requires (is_unit_v<UNIT_T>)
+    struct unit_reader {
+
+        std::array<char, 64> label{};     //< last label read, if it fits
+
+        size_t size = std::numeric_limits<size_t>::max();
+
+        long double label_factor = 1;       //< factor of the label kept
+
+        long double factor = 1;             //< factor of the last label read
+
+
+        /// @brief Set the label read and compute its factor.
+        /// @return 'invalid_argument' if the label is malformed or has not the base of UNIT_T.
+        std::errc read(std::string_view text) noexcept {
+
+            if (text == unit_label_v<UNIT_T>) {
+                this->factor = 1;
+                return std::errc{};
+            }
+            if (text.size() == this->size && std::memcmp(text.data(), this->label.data(), this->size) == 0) {
+                this->factor = this->label_factor;
+                return std::errc{};
+            }
+
+            const std::string_view source = text;
+
+            std::array<int, 7> powers;
+            int power_den;
+            intmax_t num, den;
+            int e;
+            if (const std::errc ec = read_unit_label(text, powers, power_den, num, den, e); ec != std::errc{})
+                return ec;
+
+            if (powers != UNIT_T::base_t::powers || power_den != UNIT_T::base_t::den)
+                return std::errc::invalid_argument;
+
+            using prefix_t = typename UNIT_T::prefix_t;
+            long double factor = (static_cast<long double>(num) * prefix_t::den) / (static_cast<long double>(den) * prefix_t::num);
+            for (; e > 0; --e)
+                factor *= 10;
+            for (; e < 0; ++e)
+                factor /= 10;
+
+            this->size = source.size() <= this->label.size() ? source.size() : std::numeric_limits<size_t>::max();
+            if (this->size == source.size())
+                std::memcpy(this->label.data(), source.data(), source.size());
+            this->label_factor = this->factor = factor;
+            return std::errc{};
+
+        }
+
+
+    }; // struct unit_reader
+
+
+    /// @brief Skip the blanks of a line.
+    constexpr const char* skip_blanks(const char* first, const char* last) noexcept {
+
+        while (first != last && (*first == ' ' || *first == '\t'))
+            ++first;
+        return first;
+
+    }
+
+    /// @brief Get the label that starts at first, ending at the end of the line or before an uncertainty.
+    constexpr std::string_view read_label(const char* first, const char* last) noexcept {
+
+        const char* end = first;
+        while (end != last && *end != '\n' && *end != '\r' && *end != '+')
+            ++end;
+        while (end != first && (end[-1] == ' ' || end[-1] == '\t'))
+            --end;
+        return {first, static_cast<size_t>(end - first)};
+
+    }
+
+
+    /// @brief Read a value followed by the label of its unit, rescaled into the unit of the reader.
+    template <typename T, typename UNIT_T>
+        requires (std::is_arithmetic_v<T>)
+    std::from_chars_result read_value(const char* first, const char* last, T& x, unit_reader<UNIT_T>& reader) noexcept {
+
+        std::from_chars_result r = std::from_chars(first, last, x);
+        if (r.ec != std::errc{})
+            return r;
+
+        first = skip_blanks(r.ptr, last);
+        const std::string_view label = read_label(first, last);
+        if (label.empty())
+            return {first, std::errc{}};
+
+        if (reader.read(label) != std::errc{})
+            return {first, std::errc::invalid_argument};
+        if (reader.factor != 1)
+            x = static_cast<T>(x * reader.factor);
+
+        return {label.data() + label.size(), std::errc{}};
+
+    }
+
+
+    /// @brief Parse a quantity written as its value followed by the label of its unit, like "1.25 (k)m s^-1".
+    /// @note  The label must have the base of the quantity, and its prefix is rescaled into the one of the quantity.
+    ///        A missing label means that the value is already in the unit of the quantity.
+    template <typename T>
+        requires (is_quantity_v<T> && std::is_arithmetic_v<typename T::value_t>)
+    std::from_chars_result from_chars(const char* first, const char* last, T& q, unit_reader<typename T::unit_t>& reader) noexcept {
+
+        return read_value(first, last, q.value, reader);
+
+    }
+
+    /// @brief Parse a measurement written as "9.81 +- 0.02 m s^-2", or as "9.81 m s^-2 +- 0.02 m s^-2" like 'to_chars' writes it.
+    /// @note  When the label is written only after the uncertainty, it applies to the value too.
+    template <typename T>
+        requires (is_measurement_v<T> && std::is_arithmetic_v<typename T::value_t>)
+    std::from_chars_result from_chars(const char* first, const char* last, T& m, unit_reader<typename T::unit_t>& reader) noexcept {
+
+        using value_t = typename T::value_t;
+
+        value_t val{}, unc{};
+        std::from_chars_result r = std::from_chars(first, last, val);
+        if (r.ec != std::errc{})
+            return r;
+
+        first = skip_blanks(r.ptr, last);
+        const std::string_view value_label = read_label(first, last);
+        r.ptr = first + value_label.size();
+        first = skip_blanks(r.ptr, last);
+
+        std::string_view uncertainty_label = value_label;
+        if (last - first >= 2 && first[0] == '+' && first[1] == '-') {
+
+            r = std::from_chars(skip_blanks(first + 2, last), last, unc);
+            if (r.ec != std::errc{})
+                return r;
+
+            first = skip_blanks(r.ptr, last);
+            if (const std::string_view label = read_label(first, last); !label.empty()) {
+                uncertainty_label = label;
+                r.ptr = first + label.size();
+            }
+
+        }
+
+        for (auto [x, label] : {std::pair{&val, value_label.empty() ? uncertainty_label : value_label}, std::pair{&unc, uncertainty_label}}) {
+            if (label.empty())
+                continue;
+            if (reader.read(label) != std::errc{})
+                return {label.data(), std::errc::invalid_argument};
+            if (reader.factor != 1)
+                *x = static_cast<value_t>(*x * reader.factor);
+        }
+
+        m = T(val, unc);
+        return r;
+
+    }
+
+    template <typename T>
+        requires ((is_quantity_v<T> || is_measurement_v<T>) && std::is_arithmetic_v<typename T::value_t>)
+    std::from_chars_result from_chars(const char* first, const char* last, T& x) noexcept {
+
+        unit_reader<typename T::unit_t> reader;
+        return from_chars(first, last, x, reader);
+
+    }
+
+
+    /// @brief Read the label of a unit known at runtime, like "(k)m s^-1".
+    /// @return 'invalid_argument' if the label is malformed,
+    ///         'result_out_of_range' if a power does not fit its packed byte or the prefix does not fit an exact ratio.
+    inline std::errc read_unit_label(std::string_view text, dynamic_unit& u) noexcept {
+
+        std::array<int, 7> powers;
+        int power_den;
+        intmax_t num, den;
+        int e;
+        if (const std::errc ec = read_unit_label(text, powers, power_den, num, den, e); ec != std::errc{})
+            return ec;
+
+        if (std::ranges::any_of(powers, [](int p) { return p < std::numeric_limits<int8_t>::min() || p > std::numeric_limits<int8_t>::max(); }))
+            return std::errc::result_out_of_range;
+
+        intmax_t& scaled = e > 0 ? num : den;
+        for (int k = e > 0 ? e : -e; k > 0; --k)
+            if (__builtin_mul_overflow(scaled, intmax_t(10), &scaled))
+                return std::errc::result_out_of_range;
+
+        u = {dimension::pack(powers, power_den), rational::make(num, den)};
+        return std::errc{};
+
+    }
+
+
+    /// @brief Parse a quantity whose unit is known at runtime, written as its value followed by the label of its unit.
+    /// @note  The unit is taken as it is written, with no conversion, and a missing label gives a dimensionless quantity.
+    template <typename T>
+    std::from_chars_result from_chars(const char* first, const char* last, dynamic_quantity<T>& q) noexcept {
+
+        T value{};
+        std::from_chars_result r = std::from_chars(first, last, value);
+        if (r.ec != std::errc{})
+            return r;
+
+        first = skip_blanks(r.ptr, last);
+        const std::string_view label = read_label(first, last);
+
+        dynamic_unit unit;
+        if (!label.empty()) {
+            if (const std::errc ec = read_unit_label(label, unit); ec != std::errc{})
+                return {first, ec};
+            r.ptr = label.data() + label.size();
+        }
+
+        q = {value, unit};
+        return r;
+
+    }
+
+
+    /// @brief Result of the parsing of a column.
+    struct column_result {
+
+        const char* ptr;        //< end of the text parsed, or position of the error
+
+        std::errc ec;           //< error of the parsing
+
+        size_t count;           //< number of entries parsed
+
+    }; // struct column_result
+
+
+    /// @brief Parse a column of quantities or measurements, one per line, into a caller-supplied buffer.
+    /// @note  Nothing is allocated: the labels are compared in place with the last one read,
+    ///        so a column written in a single unit is validated only once. Blank lines are skipped.
+    /// @return The number of entries parsed, stopping at the end of the text, when the buffer is full or at the first error.
+    template <typename T, size_t EXTENT>
+        requires ((is_quantity_v<T> || is_measurement_v<T>) && std::is_arithmetic_v<typename T::value_t>)
+    column_result parse_column(std::string_view text, std::span<T, EXTENT> out) noexcept {
+
+        unit_reader<typename T::unit_t> reader;
+
+        const char* first = text.data();
+        const char* const last = text.data() + text.size();
+        size_t count = 0;
+
+        while (count != out.size()) {
+
+            while (first != last && (*first == ' ' || *first == '\t' || *first == '\n' || *first == '\r'))
+                ++first;
+            if (first == last)
+                break;
+
+            const std::from_chars_result r = from_chars(first, last, out[count], reader);
+            if (r.ec != std::errc{})
+                return {r.ptr, r.ec, count};
+
+            first = skip_blanks(r.ptr, last);
+            if (first != last && *first != '\n' && *first != '\r')
+                return {first, std::errc::invalid_argument, count};
+
+            ++count;
+
+        }
+
+        return {first, std::errc{}, count};
+
+    }
+
+
+} // namespace ctda
@@ -0,0 +1,138 @@
+/**
+ * @file    precision.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the reduced precision storage types and the types used to compute and to accumulate them.
+ * @date    2023-11-24
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    /// @brief This namespace contains the reduced precision floating point storage types,
+    ///        kept apart so that the operators of 'ctda' are not found for them by argument dependent lookup.
+    namespace fp {
+
+
+        /// @brief This struct stores a brain floating point number: the 16 upper bits of a float.
+        /// @note  It is meant for storage only: it converts to float to compute, and back rounding to the nearest even.
+        struct bfloat16_t {
+
+
+            uint16_t bits;
+
+
+            constexpr bfloat16_t() noexcept = default;
+
+            constexpr bfloat16_t(float x) noexcept : bits{from_float(x)} {}
+
+
+            constexpr operator float() const noexcept {
+
+                return std::bit_cast<float>(static_cast<uint32_t>(this->bits) << 16);
+
+            }
+
+
+            /// @brief Round the bits of a float to the nearest even bfloat16, keeping the NaNs quiet.
+            static constexpr uint16_t from_float(float x) noexcept {
+
+                const uint32_t u = std::bit_cast<uint32_t>(x);
+                if ((u & 0x7FFFFFFFu) > 0x7F800000u)
+                    return static_cast<uint16_t>((u >> 16) | 0x40u);
+                return static_cast<uint16_t>((u + 0x7FFFu + ((u >> 16) & 1u)) >> 16);
+
+            }
+
+
+        }; // struct bfloat16_t
+
+
+        /// @brief This struct stores an IEEE half precision number.
+        /// @note  It is meant for storage only: it converts to float to compute, and back rounding to the nearest even.
+        struct float16_t {
+
+
+            uint16_t bits;
+
+
+            constexpr float16_t() noexcept = default;
+
+            constexpr float16_t(float x) noexcept : bits{from_float(x)} {}
+
+
+            constexpr operator float() const noexcept {
+
+                const uint32_t sign = static_cast<uint32_t>(this->bits & 0x8000u) << 16;
+                const uint32_t magnitude = this->bits & 0x7FFFu;
+
+                if (magnitude >= 0x7C00u)   // infinities and NaNs
+                    return std::bit_cast<float>(sign | 0x7F800000u | ((magnitude & 0x3FFu) << 13));
+                if (magnitude >= 0x0400u)   // normal numbers, rebiasing the exponent
+                    return std::bit_cast<float>(sign | ((magnitude + 0x1C000u) << 13));
+                return std::bit_cast<float>(sign | std::bit_cast<uint32_t>(static_cast<float>(magnitude) * 0x1p-24f));
+
+            }
+
+
+            /// @brief Round the bits of a float to the nearest even half, saturating to the infinities.
+            static constexpr uint16_t from_float(float x) noexcept {
+
+                uint32_t u = std::bit_cast<uint32_t>(x);
+                const uint32_t sign = (u >> 16) & 0x8000u;
+                u &= 0x7FFFFFFFu;
+
+                if (u >= 0x47800000u)       // out of range, infinities and NaNs
+                    return static_cast<uint16_t>(sign | (u > 0x7F800000u ? 0x7E00u : 0x7C00u));
+                if (u < 0x38800000u)        // subnormal numbers, rounded by the addition of 0.5
+                    return static_cast<uint16_t>(sign | (std::bit_cast<uint32_t>(std::bit_cast<float>(u) + 0.5f) - 0x3F000000u));
+
+                u += 0xC8000FFFu + ((u >> 13) & 1u);
+                return static_cast<uint16_t>(sign | (u >> 13));
+
+            }
+
+
+        }; // struct float16_t
+
+
+    } // namespace fp
+
+
+    using fp::bfloat16_t;
+
+    using fp::float16_t;
+
+
+    /// @brief This template meta-struct checks if a type is a reduced precision floating point type, used for storage.
+    template <typename T>
+    struct is_reduced_precision : std::false_type {};
+
+    template <>
+    struct is_reduced_precision<bfloat16_t> : std::true_type {};
+
+    template <>
+    struct is_reduced_precision<float16_t> : std::true_type {};
+
+    template <typename T>
+    inline constexpr bool is_reduced_precision_v = is_reduced_precision<T>::value;
+
+
+    /// @brief Type used to compute on the elements of type T: float for the reduced precision types, T itself otherwise.
+    template <typename T>
+    using compute_t = std::conditional_t<is_reduced_precision_v<T>, float, T>;
+
+    /// @brief Type used to accumulate the reductions of the elements of type T: double for float and for the reduced precision types.
+    template <typename T>
+    using accumulate_t = std::conditional_t<is_reduced_precision_v<T> || std::is_same_v<T, float>, double, T>;
+
+
+    static_assert(sizeof(bfloat16_t) == 2 && std::is_trivially_copyable_v<bfloat16_t> && std::is_standard_layout_v<bfloat16_t>);
+    static_assert(sizeof(float16_t) == 2 && std::is_trivially_copyable_v<float16_t> && std::is_standard_layout_v<float16_t>);
+
+
+} // namespace ctda
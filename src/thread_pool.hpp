@@ -0,0 +1,282 @@
+/**
+ * @file    thread_pool.hpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains the implementation of the work-stealing 'thread_pool' and of the execution policies.
+ * @date    2023-11-15
+ * @copyright Copyright (c) 2023
+ */
+
+
+#pragma once
+
+
+namespace ctda {
+
+
+    /// @brief This struct contains a pool of threads running parallel loops with work-stealing.
+    /// @note  Every participant of a loop owns a range of chunks: it takes them from the front,
+    ///        and when it runs out of work it steals half of the remaining chunks of another participant.
+    struct thread_pool {
+
+
+        /// @brief Constructor from the number of threads, the calling thread included.
+        /// @param threads: The number of threads taking part to a parallel loop.
+        explicit thread_pool(size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency())) {
+
+            for (size_t w = 1; w < threads; ++w)
+                this->workers.emplace_back([this, w] { this->run(w); });
+
+        }
+
+        thread_pool(const thread_pool&) = delete;
+
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        /// @brief Destructor, joins the threads.
+        ~thread_pool() noexcept {
+
+            this->stop = true;
+            ++this->generation;
+            this->generation.notify_all();
+
+            for (auto& worker : this->workers)
+                worker.join();
+
+        }
+
+
+        /// @brief Get the number of threads taking part to a parallel loop, the calling thread included.
+        size_t size() const noexcept {
+
+            return this->workers.size() + 1;
+
+        }
+
+        /// @brief Get the pool shared by the whole program.
+        static thread_pool& global() {
+
+            static thread_pool pool;
+            return pool;
+
+        }
+
+
+        /// @brief Call f(begin, end) on chunks of at least 'grain' elements covering [0, n), in parallel.
+        /// @note  A parallel loop started from inside a loop, of this pool or of any other, runs on the calling thread:
+        ///        the flag is per thread, so that two pools submitting loops to each other cannot deadlock.
+        ///        A grain of 0 is taken as 1. If f throws, the participants stop taking chunks, and the first exception is rethrown
+        ///        once all of them have left the loop.
+        template <typename FUNCTION_T>
+        void parallel_for(size_t n, size_t grain, const FUNCTION_T& f) {
+
+            grain = std::max<size_t>(grain, 1);
+            const size_t chunks = (n + grain - 1) / grain;
+            const size_t participants = std::min(chunks, this->size());
+
+            if (participants <= 1 || inside_loop) {
+                if (n > 0)
+                    f(0, n);
+                return;
+            }
+
+            std::lock_guard submit_lock(this->submit);
+
+            loop task(participants, chunks, n, grain, f);
+
+            this->current = &task;
+            task.pending = this->workers.size();
+            ++this->generation;
+            this->generation.notify_all();
+
+            task.work(0);
+
+            for (size_t pending = task.pending; pending != 0; pending = task.pending)
+                task.pending.wait(pending);
+            this->current = nullptr;
+
+            if (task.error)
+                std::rethrow_exception(task.error);
+
+        }
+
+
+      private:
+
+
+        /// @brief Range of chunks owned by a participant of a loop
+        struct range {
+            std::mutex mutex;
+            size_t begin = 0, end = 0;
+        };
+
+
+        /// @brief Flag of the thread as taking part to a loop, for the lifetime of the guard
+        struct inside_loop_guard {
+
+            inside_loop_guard() noexcept { inside_loop = true; }
+
+            ~inside_loop_guard() noexcept { inside_loop = false; }
+
+        };
+
+
+        /// @brief State of a parallel loop
+        struct loop {
+
+            std::vector<range> ranges;
+            size_t n, grain;
+            const void* f;
+            void (*call)(const void*, size_t, size_t);
+            std::atomic<size_t> pending = 0;
+
+            std::atomic<bool> failed = false;           //< set when a call throws, to stop taking chunks
+
+            std::mutex error_mutex;
+
+            std::exception_ptr error;                   //< first exception thrown
+
+            template <typename FUNCTION_T>
+            loop(size_t participants, size_t chunks, size_t n, size_t grain, const FUNCTION_T& f)
+                : ranges(participants), n{n}, grain{grain}, f{&f},
+                  call{[](const void* f, size_t begin, size_t end) { (*static_cast<const FUNCTION_T*>(f))(begin, end); }} {
+
+                for (size_t p = 0; p < participants; ++p) {
+                    this->ranges[p].begin = chunks * p / participants;
+                    this->ranges[p].end = chunks * (p + 1) / participants;
+                }
+
+            }
+
+            /// @brief Take the next chunk of the participant p, stealing from the others when its range is empty.
+            bool next(size_t p, size_t& chunk) {
+
+                if (this->failed)
+                    return false;
+
+                {
+                    std::lock_guard lock(this->ranges[p].mutex);
+                    if (this->ranges[p].begin < this->ranges[p].end) {
+                        chunk = this->ranges[p].begin++;
+                        return true;
+                    }
+                }
+
+                for (size_t k = 1; k < this->ranges.size(); ++k) {
+
+                    range& victim = this->ranges[(p + k) % this->ranges.size()];
+                    size_t begin, end;
+                    {
+                        std::lock_guard lock(victim.mutex);
+                        const size_t left = victim.end - victim.begin;
+                        if (left == 0)
+                            continue;
+                        end = victim.end;
+                        victim.end -= (left + 1) / 2;
+                        begin = victim.end;
+                    }
+
+                    std::lock_guard lock(this->ranges[p].mutex);
+                    chunk = begin;
+                    this->ranges[p].begin = begin + 1;
+                    this->ranges[p].end = end;
+                    return true;
+
+                }
+
+                return false;
+
+            }
+
+            /// @brief Run the chunks of the participant p, keeping the first exception thrown by a call.
+            void work(size_t p) noexcept {
+
+                const inside_loop_guard guard;
+
+                try {
+                    size_t chunk;
+                    while (this->next(p, chunk))
+                        this->call(this->f, chunk * this->grain, std::min(this->n, (chunk + 1) * this->grain));
+                }
+                catch (...) {
+                    std::lock_guard lock(this->error_mutex);
+                    if (!this->error)
+                        this->error = std::current_exception();
+                    this->failed = true;
+                }
+
+            }
+
+        };
+
+
+        /// @brief Loop of the worker thread w.
+        void run(size_t w) {
+
+            size_t seen = 0;
+
+            while (true) {
+
+                this->generation.wait(seen);
+                seen = this->generation;
+                if (this->stop)
+                    return;
+
+                loop* task = this->current;
+                if (w < task->ranges.size())
+                    task->work(w);
+
+                if (--task->pending == 0)
+                    task->pending.notify_one();
+
+            }
+
+        }
+
+
+        std::vector<std::thread> workers;
+
+        std::mutex submit;
+
+        loop* current = nullptr;
+
+        std::atomic<size_t> generation = 0;
+
+        bool stop = false;
+
+        inline static thread_local bool inside_loop = false;     //< set while the thread takes part to a loop of any pool
+
+
+    }; // struct thread_pool
+
+
+    /// @brief Execution policy running the operations on the calling thread
+    struct sequenced_policy {};
+
+    /// @brief Execution policy running the operations on a thread pool, the global one by default
+    struct parallel_policy {
+
+        thread_pool* pool = nullptr;
+
+        /// @brief Get the policy running on a specific pool.
+        constexpr parallel_policy operator()(thread_pool& pool) const noexcept {
+            return {&pool};
+        }
+
+    };
+
+    inline constexpr sequenced_policy seq{};
+
+    inline constexpr parallel_policy par{};
+
+
+    /// @brief This template meta-struct checks if a type is an execution policy.
+    template <typename T>
+    struct is_execution_policy : std::disjunction<std::is_same<T, sequenced_policy>,
+                                                  std::is_same<T, parallel_policy>,
+                                                  std::is_same<T, thread_pool>> {};
+
+    template <typename T>
+    inline constexpr bool is_execution_policy_v = is_execution_policy<T>::value;
+
+
+} // namespace ctda
@@ -13,15 +13,15 @@
 namespace ctda {
 
 
-    template <int LENGTH, int TIME, int MASS, int TEMPERATURE, int ELETTRIC_CURRENT, int SUBSTANCE_AMOUNT, int LUMINOUS_INTENSITY>
-    struct base_quantity;
+    template <uint64_t POWERS>
+    struct packed_base;
 
     /// @brief This template meta-struct checks if a type is a base.
     template <typename T>
     struct is_base : std::false_type {};
 
-    template <int LENGTH, int TIME, int MASS, int TEMPERATURE, int ELETTRIC_CURRENT, int SUBSTANCE_AMOUNT, int LUMINOUS_INTENSITY>
-    struct is_base<base_quantity<LENGTH, TIME, MASS, TEMPERATURE, ELETTRIC_CURRENT, SUBSTANCE_AMOUNT, LUMINOUS_INTENSITY>> : std::true_type {};
+    template <uint64_t POWERS>
+    struct is_base<packed_base<POWERS>> : std::true_type {};
     
     template <typename T>
     inline constexpr bool is_base_v = is_base<T>::value;
@@ -32,7 +32,7 @@ namespace ctda {
     /// @brief This template meta-struct checks if two base are the same.
     template <typename T1, typename T2>
         requires (are_base_v<T1, T2>)
-    inline constexpr bool are_same_base_v = std::is_same_v<typename T1::powers, typename T2::powers>;
+    inline constexpr bool are_same_base_v = T1::packed == T2::packed;
 
 
     /// @brief This template meta-struct checks if a type is a prefix.
@@ -66,10 +66,15 @@ namespace ctda {
     template <typename... Ts>
     inline constexpr bool are_unit_v = std::conjunction_v<is_unit<Ts>...>;
 
+    /// @brief Exact ratio converting a value expressed in the FROM unit to the TO unit.
     template <typename FROM, typename TO>
         requires (are_unit_v<FROM, TO> && std::is_same_v<typename FROM::base_t, typename TO::base_t>)
-    constexpr auto convertion_factor(const FROM&, const TO& ) {
-        return FROM::factor / TO::factor;
+    using conversion_t = std::ratio_divide<typename FROM::prefix_t, typename TO::prefix_t>;
+
+    template <typename FROM, typename TO>
+        requires (are_unit_v<FROM, TO> && std::is_same_v<typename FROM::base_t, typename TO::base_t>)
+    constexpr long double conversion_factor(const FROM&, const TO&) noexcept {
+        return static_cast<long double>(conversion_t<FROM, TO>::num) / static_cast<long double>(conversion_t<FROM, TO>::den);
     }
 
 
@@ -119,6 +124,21 @@ namespace ctda {
     inline constexpr bool are_measurement_v = std::conjunction_v<is_measurement<Ts>...>;
 
 
+    template <typename quantity_t>
+        requires (is_quantity_v<quantity_t> && std::is_floating_point_v<typename quantity_t::value_t>)
+    struct correlated;
+
+    /// @brief This template meta-struct checks if a type is a measurement tracking its correlations.
+    template <typename T>
+    struct is_correlated : std::false_type {};
+
+    template <typename T>
+    struct is_correlated<correlated<T>> : std::true_type {};
+
+    template <typename T>
+    inline constexpr bool is_correlated_v = is_correlated<T>::value;
+
+
     /// @brief This template meta-struct checks if a type is a complex number.
     template <typename T>
     struct is_complex : std::false_type {};
@@ -133,4 +153,107 @@ namespace ctda {
     inline constexpr bool are_complex_v = std::conjunction_v<is_complex<Ts>...>;
 
 
+    /// @brief This template meta-struct checks if a type is a scalar (a number or a complex number).
+    template <typename T>
+    struct is_scalar : std::disjunction<std::is_arithmetic<T>, is_complex<T>> {};
+
+    template <typename T>
+    inline constexpr bool is_scalar_v = is_scalar<T>::value;
+
+
+    namespace ad {
+
+        template <typename T, size_t N>
+            requires ((std::is_same_v<T, float> || std::is_same_v<T, double>) && N > 0)
+        struct dual;
+
+    } // namespace ad
+
+    using ad::dual;
+
+    /// @brief This template meta-struct checks if a type is a dual number.
+    template <typename T>
+    struct is_dual : std::false_type {};
+
+    template <typename T, size_t N>
+    struct is_dual<dual<T, N>> : std::true_type {};
+
+    template <typename T>
+    inline constexpr bool is_dual_v = is_dual<T>::value;
+
+
+    namespace split {
+
+        template <typename T, typename ALLOC_T = std::allocator<T>>
+            requires (std::is_floating_point_v<T>)
+        struct complex_vector;
+
+    } // namespace split
+
+    using split::complex_vector;
+
+    /// @brief This template meta-struct checks if a type is a vector of complex numbers stored in split planes.
+    template <typename T>
+    struct is_complex_vector : std::false_type {};
+
+    template <typename T, typename ALLOC_T>
+    struct is_complex_vector<complex_vector<T, ALLOC_T>> : std::true_type {};
+
+    template <typename T>
+    inline constexpr bool is_complex_vector_v = is_complex_vector<T>::value;
+
+
+    namespace runtime {
+
+        template <typename T>
+            requires (std::is_arithmetic_v<T>)
+        struct dynamic_quantity;
+
+    } // namespace runtime
+
+    using runtime::dynamic_quantity;
+
+    /// @brief This template meta-struct checks if a type is a quantity whose unit is known at runtime.
+    template <typename T>
+    struct is_dynamic_quantity : std::false_type {};
+
+    template <typename T>
+    struct is_dynamic_quantity<dynamic_quantity<T>> : std::true_type {};
+
+    template <typename T>
+    inline constexpr bool is_dynamic_quantity_v = is_dynamic_quantity<T>::value;
+
+
+    template <typename OP_T, typename... ARGS_T>
+    struct expression;
+
+    /// @brief This template meta-struct checks if a type is a lazy expression.
+    template <typename T>
+    struct is_expression : std::false_type {};
+
+    template <typename OP_T, typename... ARGS_T>
+    struct is_expression<expression<OP_T, ARGS_T...>> : std::true_type {};
+
+    template <typename T>
+    inline constexpr bool is_expression_v = is_expression<T>::value;
+
+    /// @brief This template meta-struct checks if a type can be a leaf or a node of a lazy expression.
+    template <typename T>
+    struct is_expression_operand : is_expression<T> {};
+
+    template <typename T, typename ALLOC_T>
+        requires (is_scalar_v<T> || is_reduced_precision_v<T>)
+    struct is_expression_operand<std::vector<T, ALLOC_T>> : std::true_type {};
+
+    template <typename T>
+        requires (is_scalar_v<std::remove_cv_t<T>> || is_reduced_precision_v<std::remove_cv_t<T>>)
+    struct is_expression_operand<std::span<T>> : std::true_type {};
+
+    template <typename T>
+    inline constexpr bool is_expression_operand_v = is_expression_operand<T>::value;
+
+    template <typename... Ts>
+    inline constexpr bool are_expression_operand_v = std::conjunction_v<is_expression_operand<Ts>...>;
+
+
 } // namespace ctda
\ No newline at end of file
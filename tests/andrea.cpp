@@ -1,4 +1,5 @@
 #include "ctda.hpp"
+#include "ctda_io.hpp"
 #include <iostream>
 
 using namespace ctda;
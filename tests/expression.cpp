@@ -0,0 +1,355 @@
+/**
+ * @file    tests/expression.cpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains a test for the lazy 'expression' struct.
+ * @date    2023-11-06
+ * @copyright Copyright (c) 2023
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+
+#include "ctda.hpp"
+#include "ctda_parallel.hpp"
+
+using namespace ctda;
+using namespace units;
+
+
+class ExpressionTest : public testing::Test {
+protected:
+    using m2 = math::square_t<meter>;
+    using column = std::vector<double>;
+};
+
+
+TEST_F(ExpressionTest, LazyEvaluation) {
+
+    auto a = quantity<column, m2>({1.0, 2.0, 3.0});
+    auto b = quantity<column, meter>({1.0, 2.0, 3.0});
+    auto c = quantity<column, meter>({2.0, 2.0, 2.0});
+    auto d = quantity<column, m2>({0.5, 0.5, 0.5});
+
+    auto e = a + b * c - d;
+    static_assert(is_expression_v<decltype(e.value)>);
+    static_assert(std::is_same_v<decltype(e)::unit_t, m2>);
+    ASSERT_EQ(e.value.size(), 3);
+    ASSERT_DOUBLE_EQ(e.value[1], 5.5);
+
+    quantity<column, m2> r = e;
+    ASSERT_EQ(r.value, (column{2.5, 5.5, 8.5}));
+
+    r = r * 2.0 - a;
+    ASSERT_EQ(r.value, (column{4.0, 9.0, 14.0}));
+
+    r += a;
+    ASSERT_EQ(r.value, (column{5.0, 11.0, 17.0}));
+
+    quantity<column, m2> s = math::sq(b) / 2.0;
+    ASSERT_EQ(s.value, (column{0.5, 2.0, 4.5}));
+
+    quantity<column, meter> t = math::sqrt(a * 4.0);
+    ASSERT_DOUBLE_EQ(t.value[3 - 1], std::sqrt(12.0));
+
+}
+
+
+TEST_F(ExpressionTest, VectorizedEvaluation) {
+
+    const size_t n = 1003;
+    column x(n), y(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = 1.0 + i;
+        y[i] = 0.5 * i;
+    }
+
+    auto a = quantity<column, meter>(x);
+    auto b = quantity<column, meter>(y);
+
+    static_assert(decltype((a + b * 2.0).value)::vectorizable);
+    static_assert(!decltype(math::root<3>(a).value)::vectorizable);
+
+    quantity<column, m2> r = math::sqrt(math::sq(a * a) + math::sq(b * b)) - a / math::inv(b);
+    quantity<column, meter> t = -(a + b * 2.0);
+    quantity<column, meter> u = math::root<3>(math::cb(a));
+
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_DOUBLE_EQ(r.value[i], std::sqrt(std::pow(x[i], 4) + std::pow(y[i], 4)) - x[i] * y[i]);
+        ASSERT_DOUBLE_EQ(t.value[i], -(x[i] + y[i] * 2.0));
+        ASSERT_DOUBLE_EQ(u.value[i], x[i]);
+    }
+
+    std::array<double, 16> v{};
+    for (size_t i = 0; i < v.size(); ++i)
+        v[i] = 1.0 + i;
+
+    auto w = math::sqrt(math::inv(math::sq(v) * 4.0));
+    for (size_t i = 0; i < v.size(); ++i)
+        ASSERT_DOUBLE_EQ(w[i], 0.5 / v[i]);
+
+}
+
+
+TEST_F(ExpressionTest, SubtractDivide) {
+
+    auto a = quantity<column, meter>({3.0, 6.0, 9.0});
+    auto b = quantity<column, second>({1.0, 2.0, 4.0});
+
+    auto v = a / b;
+    static_assert(std::is_same_v<decltype(v.value), expression<math::divide_op, column, column>>);
+    static_assert(std::is_same_v<decltype(v)::base_t, basis::velocity>);
+
+    quantity<column, math::divide_t<meter, second>> r = v - a / b * 0.5;
+    ASSERT_EQ(r.value, (column{1.5, 1.5, 1.125}));
+
+    quantity<column, math::invert_t<second>> f = 1.0 / b;
+    ASSERT_EQ(f.value, (column{1.0, 0.5, 0.25}));
+
+    measurement_vector<quantity<double, meter>> x({3.0, 6.0}, {0.3, 0.6});
+    measurement_vector<quantity<double, second>> t({1.0, 2.0}, {0.1, 0.2});
+
+    auto u = x / t;
+    ASSERT_EQ(u.val, (column{3.0, 3.0}));
+    ASSERT_DOUBLE_EQ(u.unc[1], 3.0 * std::sqrt(0.02));
+
+    auto d = x - x;
+    ASSERT_EQ(d.val, (column{0.0, 0.0}));
+    ASSERT_DOUBLE_EQ(d.unc[0], 0.3 * std::sqrt(2.0));
+
+}
+
+
+TEST_F(ExpressionTest, ParallelEvaluation) {
+
+    thread_pool pool(4);
+
+    const size_t n = 100000;
+    auto a = quantity<column, meter>(column(n, 3.0));
+    auto b = quantity<column, unit<basis::length, std::centi>>(column(n, 50.0));
+    for (size_t i = 0; i < n; ++i)
+        a.value[i] += static_cast<double>(i);
+
+    auto s = math::add(pool, a, b);
+    auto p = math::add(seq, a, b);
+    static_assert(std::is_same_v<decltype(s), quantity<column, meter>>);
+    ASSERT_EQ(s.value, p.value);
+    ASSERT_DOUBLE_EQ(s.value[n - 1], 3.5 + static_cast<double>(n - 1));
+
+    auto r = math::sqrt(par(pool), math::mult(par(pool), a, a));
+    ASSERT_EQ(r.value, a.value);
+
+    auto x = std::make_unique<std::array<double, 8192>>();
+    std::ranges::fill(*x, 4.0);
+    auto y = math::div(par, *x, 2.0);
+    static_assert(std::is_same_v<decltype(y), std::array<double, 8192>>);
+    ASSERT_TRUE(std::ranges::all_of(y, [](double v) { return v == 2.0; }));
+
+    std::atomic<size_t> count = 0;
+    pool.parallel_for(n, 1000, [&](size_t begin, size_t end) {
+        pool.parallel_for(end - begin, 10, [&](size_t b, size_t e) { count.fetch_add(e - b); });
+    });
+    ASSERT_EQ(count, n);
+
+}
+
+
+TEST_F(ExpressionTest, ParallelException) {
+
+    thread_pool pool(4);
+    const size_t n = 100000;
+
+    // thrown by the calling thread, which runs the first chunk, and by a worker
+    for (size_t bad : {size_t(0), n - 1}) {
+        std::atomic<size_t> count = 0;
+        EXPECT_THROW(pool.parallel_for(n, 100, [&](size_t begin, size_t end) {
+            if (begin <= bad && bad < end)
+                throw std::runtime_error("bad chunk");
+            count.fetch_add(end - begin);
+        }), std::runtime_error);
+        ASSERT_LT(count, n);
+    }
+
+    // the pool is left usable, and the calling thread splits its loops in chunks again
+    std::atomic<size_t> count = 0, largest = 0;
+    pool.parallel_for(n, 1000, [&](size_t begin, size_t end) {
+        count.fetch_add(end - begin);
+        for (size_t seen = largest; seen < end - begin && !largest.compare_exchange_weak(seen, end - begin);) {}
+    });
+    ASSERT_EQ(count, n);
+    ASSERT_EQ(largest, 1000);
+
+    // a grain of zero still covers the whole range
+    count = 0;
+    pool.parallel_for(n, 0, [&](size_t begin, size_t end) { count.fetch_add(end - begin); });
+    ASSERT_EQ(count, n);
+
+}
+
+
+TEST_F(ExpressionTest, AllocatorAware) {
+
+    using pmr_column = std::pmr::vector<double>;
+
+    std::array<std::byte, 4096> storage;
+    std::pmr::monotonic_buffer_resource pool(storage.data(), storage.size(), std::pmr::null_memory_resource());
+
+    auto a = quantity<pmr_column, meter>(pmr_column({1.0, 2.0, 3.0}, &pool));
+    auto b = quantity<pmr_column, meter>(pmr_column({3.0, 2.0, 1.0}, &pool));
+
+    {
+        memory::arena batch(1024);
+        quantity<pmr_column, math::square_t<meter>> c = a * b + a * a;
+        ASSERT_EQ(c.value.get_allocator().resource(), batch.resource());
+        ASSERT_EQ(c.value, (pmr_column{4.0, 8.0, 12.0}));
+
+        auto d = math::sqrt(c.value);
+        static_assert(std::is_same_v<decltype(d)::result_t, pmr_column>);
+        ASSERT_EQ(d.get_allocator().resource(), batch.resource());
+
+        thread_pool threads(2);
+        const auto e = math::add(threads, a, b);
+        static_assert(std::is_same_v<decltype(e), const quantity<pmr_column, meter>>);
+        ASSERT_EQ(e.value.get_allocator().resource(), batch.resource());
+        ASSERT_EQ(e.value, (pmr_column{4.0, 4.0, 4.0}));
+    }
+    ASSERT_EQ(memory::resource(), std::pmr::get_default_resource());
+
+    std::array<double, 3> buffer{};
+    quantity<std::span<double>, meter> out(buffer);
+    out = a + b;
+    ASSERT_EQ(buffer, (std::array<double, 3>{4.0, 4.0, 4.0}));
+
+    std::array<double, 2> small{};
+    quantity<std::span<double>, meter> wrong(small);
+    ASSERT_THROW((wrong = a + b), std::runtime_error);
+
+}
+
+
+TEST_F(ExpressionTest, ParallelAllocations) {
+
+    // a resource counting its allocations, as the default one while the operation runs
+    struct counting_resource : std::pmr::memory_resource {
+        size_t count = 0;
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            ++this->count;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    using pmr_column = std::pmr::vector<double>;
+
+    const auto a = quantity<pmr_column, meter>(pmr_column(10000, 1.0));
+    const auto b = quantity<pmr_column, meter>(pmr_column(10000, 2.0));
+    thread_pool threads(2);
+
+    counting_resource counter;
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(&counter);
+    const auto c = math::add(threads, a, b);
+    std::pmr::set_default_resource(previous);
+
+    // only the result is allocated, as in the sequential 'a + b'
+    ASSERT_EQ(counter.count, 1);
+    ASSERT_TRUE(std::ranges::all_of(c.value, [](double v) { return v == 3.0; }));
+
+}
+
+
+TEST_F(ExpressionTest, CompoundAssignment) {
+
+    auto a = quantity<column, meter>({1.0, 2.0, 3.0});
+    auto b = quantity<column, unit<basis::length, std::milli>>({1000.0, 1000.0, 1000.0});
+    const double* data = a.value.data();
+
+    a += b;
+    a -= quantity<column, meter>({0.5, 0.5, 0.5});
+    a.value += a.value * a.value;
+    a *= 2.0;
+    a /= 4.0;
+    ASSERT_EQ(a.value.data(), data);
+    ASSERT_EQ(a.value, (column{1.875, 4.375, 7.875}));
+
+    std::array<double, 16> x{}, y{};
+    x.fill(1.0);
+    y.fill(3.0);
+    x += y;
+    x *= y;
+    x /= 2.0;
+    ASSERT_TRUE(std::ranges::all_of(x, [](double v) { return v == 6.0; }));
+
+    auto s = quantity<double, second>(1.0);
+    s += quantity<double, second>(2.0);
+    ASSERT_EQ((s -= quantity<double, second>(0.5)).value, 2.5);
+
+}
+
+
+TEST_F(ExpressionTest, SizeMismatch) {
+
+    auto a = quantity<column, meter>({1.0, 2.0, 3.0});
+    auto b = quantity<column, meter>({1.0, 2.0});
+
+    ASSERT_THROW((math::add(a.value, b.value)), std::runtime_error);
+    EXPECT_THROW((a + b), std::runtime_error);
+    EXPECT_THROW((a * b), std::runtime_error);
+    EXPECT_THROW((a + quantity<column, unit<basis::length, std::milli>>({1.0, 2.0})), std::runtime_error);
+
+}
+
+
+TEST_F(ExpressionTest, ReducedPrecision) {
+
+    constexpr size_t N = 1000;
+    std::vector<bfloat16_t> a(N), b(N);
+    for (size_t i = 0; i < N; ++i) {
+        a[i] = static_cast<float>(i) * 0.5f;
+        b[i] = 2.0f;
+    }
+    static_assert(sizeof(a[0]) == 2);
+    ASSERT_EQ(static_cast<float>(bfloat16_t(1.00390625f)), 1.0f);
+    ASSERT_EQ(static_cast<float>(bfloat16_t(1.01171875f)), 1.015625f);
+
+    auto x = quantity<std::vector<bfloat16_t>, meter>(a);
+    auto y = quantity<std::vector<bfloat16_t>, meter>(b);
+    static_assert(std::is_same_v<typename decltype((x + y).value)::value_type, float>);
+    static_assert(decltype((x + y).value)::vectorizable);
+
+    quantity<std::vector<bfloat16_t>, meter> z = x * 2.0f + y;
+    ASSERT_EQ(static_cast<float>(z.value[3]), 5.0f);
+    ASSERT_EQ(static_cast<float>(z.value[N - 1]), static_cast<float>(bfloat16_t(static_cast<float>(a[N - 1]) * 2.0f + 2.0f)));
+
+    quantity<std::vector<float>, meter> wide = x + y;
+    ASSERT_EQ(wide.value[N - 1], static_cast<float>(a[N - 1]) + 2.0f);
+
+    ASSERT_EQ(static_cast<float>(float16_t(65504.0f)), 65504.0f);
+    ASSERT_EQ(static_cast<float>(float16_t(0x1p-24f)), 0x1p-24f);
+    ASSERT_EQ(static_cast<float>(float16_t(1.00048828125f)), 1.0f);
+    auto h = quantity<std::vector<float16_t>, meter>(std::vector<float16_t>(N, float16_t(0.25f)));
+    quantity<std::vector<float16_t>, meter> k = h * 3.0f + h;
+    ASSERT_EQ(static_cast<float>(k.value[N - 1]), 1.0f);
+
+    math::accumulator<quantity<bfloat16_t, meter>> acc;
+    static_assert(std::is_same_v<typename decltype(acc)::value_t, double>);
+    acc.push(x);
+    ASSERT_EQ(acc.count(), N);
+    double sum = 0;
+    for (const auto& v : a)
+        sum += static_cast<float>(v);
+    ASSERT_DOUBLE_EQ(acc.mean().value, sum / N);
+
+}
+
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
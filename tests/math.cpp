@@ -11,6 +11,8 @@
 #include <gtest/gtest.h>
 
 #include "ctda.hpp"
+#include "ctda_linear_algebra.hpp"
+#include "ctda_io.hpp"
 
 using namespace ctda;
 using namespace units;
@@ -86,6 +88,353 @@ TEST_F(QuantityTest, QuantityArithmeticOperations) {
 }
 
 
+TEST_F(QuantityTest, DualDerivatives) {
+
+    using length = quantity<dual<double, 3>, meter>;
+    using duration = quantity<dual<double, 3>, s>;
+
+    const length x = math::variable<3>(quantity<double, meter>(3.0), 0);
+    const quantity<dual<double, 3>, cm> h = math::variable<3>(quantity<double, cm>(400.0), 1);
+    const duration t = math::variable<3>(quantity<double, s>(2.0), 2);
+
+    // area over time, in metres times centimetres per second
+    const auto rate = x * h / t;
+    ASSERT_DOUBLE_EQ(math::primal(rate).value, 600.0);
+    ASSERT_DOUBLE_EQ(math::derivative(rate, x).value, 200.0);
+    ASSERT_DOUBLE_EQ(math::derivative(rate, t).value, -300.0);
+    static_assert(std::is_same_v<decltype(math::derivative(rate, t))::unit_t, math::divide_t<decltype(rate)::unit_t, s>>);
+
+    // the derivative with respect to h is in the unit of the rate over centimetres
+    const auto by_height = math::derivative(rate, h);
+    static_assert(std::is_same_v<decltype(by_height)::unit_t, math::divide_t<decltype(rate)::unit_t, cm>>);
+    ASSERT_NEAR(by_height.value, 1.5, 1e-12);
+    ASSERT_NEAR(math::derivative<cm>(rate, 1).value, by_height.value, 1e-15);
+
+    const auto diagonal = math::sqrt(x * x + math::pow<2>(quantity<dual<double, 3>, meter>(4.0)));
+    ASSERT_DOUBLE_EQ(math::primal(diagonal).value, 5.0);
+    ASSERT_DOUBLE_EQ(math::derivative(diagonal, x).value, 0.6);
+    ASSERT_DOUBLE_EQ(math::derivative((-x + 1.0 * x) / (2.0 * t), x).value, 0.0);
+
+    // first order propagation with the exact gradient of a non linear formula
+    const measurement<quantity<double, meter>> side(2.0, 0.01);
+    const measurement<quantity<double, s>> time(4.0, 0.02);
+    const auto m = math::propagate([](const auto& l, const auto& t) { return l * l * l / t; }, side, time);
+    static_assert(std::is_same_v<decltype(m)::unit_t, math::divide_t<math::cube_t<meter>, s>>);
+    ASSERT_DOUBLE_EQ(m.val, 2.0);
+    ASSERT_NEAR(m.unc, std::hypot(3 * 4.0 / 4.0 * 0.01, 2.0 / 4.0 * 0.02), 1e-12);
+
+}
+
+
+TEST_F(QuantityTest, SplitComplex) {
+
+    using milliampere = unit<basis::elettric_current, std::milli>;
+
+    // an odd size exercises the tails of the kernels, the first numbers the axes of the phase
+    const size_t n = 1003;
+    std::vector<std::complex<double>> z(n), w(n);
+    for (size_t i = 0; i < n; ++i) {
+        const double t = static_cast<double>(i) - 501.0;
+        z[i] = {t, (i % 3 == 0 ? -1.0 : 1.0) * (0.5 * t + 1.0)};
+        w[i] = std::polar(1.0 + 0.01 * static_cast<double>(i), 0.013 * t);
+    }
+    z[0] = {0.0, 0.0};
+    z[1] = {-2.0, 0.0};
+    z[2] = {-2.0, -0.0};
+    z[3] = {0.0, -4.0};
+
+    const quantity<complex_vector<double>, ampere> current(complex_vector<double>{z});
+    const quantity<complex_vector<double>> gain(complex_vector<double>{w});
+    ASSERT_EQ(current.value.size(), n);
+    ASSERT_TRUE(std::ranges::equal(current.value.interleaved(), z));
+
+    const auto product = current * gain;
+    const auto sum = current + quantity<complex_vector<double>, milliampere>(complex_vector<double>{z});
+    const auto rotated = current * std::complex<double>(0.0, 1.0);
+    const auto twice = 2.0 * current;
+    const auto conjugate = math::conj(current);
+    const auto magnitude = math::abs(current);
+    const auto phase = math::arg(current);
+    static_assert(std::is_same_v<decltype(product)::unit_t, ampere>);
+    static_assert(std::is_same_v<decltype(magnitude)::value_t, std::vector<double>>);
+    static_assert(std::is_same_v<decltype(phase)::unit_t::base_t, basis::dimensionless>);
+
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_NEAR(std::abs(product.value[i] - z[i] * w[i]), 0.0, 1e-12 * std::abs(z[i] * w[i]));
+        ASSERT_NEAR(std::abs(sum.value[i] - 1.001 * z[i]), 0.0, 1e-12 * std::abs(z[i]));
+        ASSERT_EQ(rotated.value[i], std::complex<double>(-z[i].imag(), z[i].real()));
+        ASSERT_EQ(twice.value[i], 2.0 * z[i]);
+        ASSERT_EQ(conjugate.value[i], std::conj(z[i]));
+        ASSERT_NEAR(magnitude.value[i], std::abs(z[i]), 1e-15 * std::abs(z[i]));
+        ASSERT_NEAR(phase.value[i], std::arg(z[i]), 1e-15);
+    }
+    ASSERT_TRUE(std::ranges::all_of((current - current).value.re, [](double x) { return x == 0.0; }));
+
+    const complex_vector<float> single{{3.0f, -4.0f}, {-1.0f, 1e-3f}, {-1.0f, -1e3f}};
+    ASSERT_NEAR(math::abs(single)[0], 5.0f, 1e-6f);
+    for (size_t i = 0; i < single.size(); ++i)
+        ASSERT_NEAR(math::arg(single)[i], std::arg(single[i]), 1e-6f);
+
+    // the squares of the parts overflow or underflow at the extremes, where 'std::abs' is still exact
+    std::vector<std::complex<double>> extremes(37, {3.0, 4.0});
+    extremes[0] = {3e200, -4e200};
+    extremes[5] = {-1e300, 1.0};
+    extremes[16] = {3e-170, 4e-170};
+    extremes[33] = {5e-324, 0.0};
+    extremes[36] = {std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN()};
+    const auto large = math::abs(complex_vector<double>{extremes});
+    for (size_t i = 0; i < extremes.size(); ++i)
+        ASSERT_DOUBLE_EQ(large[i], std::abs(extremes[i]));
+    const complex_vector<float> tiny{{3e-30f, 4e-30f}, {3e30f, 4e30f}, {3.0f, 4.0f}};
+    for (size_t i = 0; i < tiny.size(); ++i)
+        ASSERT_FLOAT_EQ(math::abs(tiny)[i], std::abs(tiny[i]));
+
+    std::vector<std::complex<double>> shorter(n - 1);
+    ASSERT_THROW(current.value.interleave(shorter), std::runtime_error);
+
+}
+
+TEST_F(QuantityTest, QuantityTimesArray) {
+
+    // a scalar quantity broadcasted on the kernels, with a tail
+    std::array<double, 19> x{};
+    for (size_t i = 0; i < x.size(); ++i)
+        x[i] = 0.5 + static_cast<double>(i);
+    const quantity<double, cm> q(4.0);
+
+    static_assert(math::multiply_impl<quantity<double, cm>, std::array<double, 19>>::vectorizable);
+    static_assert(math::multiply_impl<std::array<double, 19>, quantity<double, cm>>::vectorizable);
+    static_assert(!math::multiply_impl<quantity<double, cm>, std::array<double, 4>>::vectorizable);
+
+    const quantity<std::array<double, 19>, cm> left = q * x, right = x * q;
+    for (size_t i = 0; i < x.size(); ++i) {
+        ASSERT_DOUBLE_EQ(left.value[i], 4.0 * x[i]);
+        ASSERT_DOUBLE_EQ(right.value[i], 4.0 * x[i]);
+    }
+
+    // the same product evaluated at compile time, off the kernels
+    static constexpr auto folded = quantity<double, cm>(2.0) * std::array<double, 8>{1, 2, 3, 4, 5, 6, 7, 8};
+    static_assert(folded.value[7] == 16.0);
+
+}
+
+
+TEST_F(QuantityTest, MatrixProduct) {
+
+    const quantity<std::array<std::array<double, 3>, 2>, cm> a({{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}}});
+    const quantity<std::array<std::array<double, 2>, 3>, s> b({{{7.0, 8.0}, {9.0, 10.0}, {11.0, 12.0}}});
+    const auto c = math::matmul(a, b);
+    static_assert(std::is_same_v<decltype(c)::unit_t, math::multiply_t<cm, s>>);
+    ASSERT_DOUBLE_EQ(c.value[0][0], 58.0);
+    ASSERT_DOUBLE_EQ(c.value[0][1], 64.0);
+    ASSERT_DOUBLE_EQ(c.value[1][0], 139.0);
+    ASSERT_DOUBLE_EQ(c.value[1][1], 154.0);
+
+    const auto y = math::matmul(a, quantity<std::array<double, 3>, s>({1.0, 0.0, -1.0}));
+    ASSERT_DOUBLE_EQ(y.value[0], -2.0);
+    ASSERT_DOUBLE_EQ(y.value[1], -2.0);
+    const quantity<std::array<double, 3>, cm> row(a.value[1]);
+    ASSERT_DOUBLE_EQ(math::dot(row, row).value, 77.0);
+    static_assert(std::is_same_v<decltype(math::dot(row, row))::unit_t, math::square_t<cm>>);
+    static_assert(math::matmul(std::array<std::array<int, 2>, 1>{{{1, 2}}}, std::array<std::array<int, 1>, 2>{{{3}, {4}}})[0][0] == 11);
+
+    // odd shapes leave partial tiles on every edge of the blocked kernel
+    constexpr size_t M = 37, K = 53, N = 29;
+    auto big_a = std::make_unique<std::array<std::array<double, K>, M>>();
+    auto big_b = std::make_unique<std::array<std::array<double, N>, K>>();
+    for (size_t i = 0; i < M; ++i)
+        for (size_t p = 0; p < K; ++p)
+            (*big_a)[i][p] = std::sin(static_cast<double>(i * K + p));
+    for (size_t p = 0; p < K; ++p)
+        for (size_t j = 0; j < N; ++j)
+            (*big_b)[p][j] = std::cos(static_cast<double>(p * N + j));
+    const auto big_c = math::matmul(*big_a, *big_b);
+    for (size_t i = 0; i < M; ++i)
+        for (size_t j = 0; j < N; ++j) {
+            double expected = 0.0;
+            for (size_t p = 0; p < K; ++p)
+                expected += (*big_a)[i][p] * (*big_b)[p][j];
+            ASSERT_NEAR(big_c[i][j], expected, 1e-12);
+        }
+
+    // heap matrices deeper than a block of the kernel, written in metre seconds
+    const size_t m = 70, k = 600, n = 45;
+    std::vector<double> x(m * k), w(k * n), out(m * n);
+    for (size_t i = 0; i < x.size(); ++i)
+        x[i] = std::sin(0.1 * static_cast<double>(i));
+    for (size_t i = 0; i < w.size(); ++i)
+        w[i] = std::cos(0.3 * static_cast<double>(i));
+    math::matmul(as_mdview<cm>(static_cast<const double*>(x.data()), m, k), as_mdview<s>(w.data(), k, n), 
+                 as_mdview<unit<math::multiply_t<cm, s>::base_t>>(out.data(), m, n));
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < n; ++j) {
+            double expected = 0.0;
+            for (size_t p = 0; p < k; ++p)
+                expected += x[i * k + p] * w[p * n + j];
+            ASSERT_NEAR(out[i * n + j], expected / 100, 1e-12);
+        }
+
+    double norm = 0.0;
+    for (double v : x)
+        norm += v * v;
+    ASSERT_NEAR((math::dot(quantity<std::vector<double>, cm>(x), quantity<std::span<const double>, cm>(x)).value), norm, 1e-9);
+    ASSERT_THROW(math::matmul(as_mdview<cm>(x.data(), m, k), as_mdview<s>(w.data(), n, k), as_mdview<math::multiply_t<cm, s>>(out.data(), m, n)), std::runtime_error);
+
+}
+
+TEST_F(QuantityTest, IntegerPowers) {
+
+    // numbers, by squaring at compile time and at runtime
+    static_assert(math::pow<10>(2) == 1024 && math::pow<0>(7.0) == 1.0 && math::pow<-2>(4.0) == 0.0625);
+    ASSERT_DOUBLE_EQ(math::pow<7>(1.1), 1.1 * 1.1 * 1.1 * 1.1 * 1.1 * 1.1 * 1.1);
+    ASSERT_DOUBLE_EQ(math::pow<-3>(2.0), 0.125);
+    ASSERT_FLOAT_EQ(math::cb(1.5f), 3.375f);
+
+    // exact prefixes, beyond the precision of a double
+    static_assert(std::is_same_v<math::power_t<3, std::milli>, std::nano>);
+    static_assert(std::is_same_v<math::power_t<-2, std::kilo>, std::micro>);
+    static_assert(std::is_same_v<math::power_t<3, std::ratio<3, 1000>>, std::ratio<27, 1000000000>>);
+    static_assert(std::is_same_v<math::power_t<2, std::ratio<999999999, 1000>>, std::ratio<999999998000000001, 1000000>>);
+    static_assert(std::is_same_v<math::square_t<unit<basis::length, std::kilo>>, unit<basis::area, std::mega>>);
+
+    // columns and arrays, with the tails of the kernels
+    std::vector<double> x(37);
+    for (size_t i = 0; i < x.size(); ++i)
+        x[i] = 0.5 + 0.1 * static_cast<double>(i);
+    const quantity<std::vector<double>, cm> q(x);
+    const quantity<std::vector<double>, math::power_t<-5, cm>> r = math::pow<-5>(q);
+    const quantity<std::vector<double>, math::cube_t<cm>> c = math::cb(q);
+    for (size_t i = 0; i < x.size(); ++i) {
+        ASSERT_NEAR(r.value[i], std::pow(x[i], -5), 1e-14 * std::pow(x[i], -5));
+        ASSERT_NEAR(c.value[i], x[i] * x[i] * x[i], 1e-14 * x[i] * x[i] * x[i]);
+    }
+
+    std::array<float, 19> a{};
+    for (size_t i = 0; i < a.size(); ++i)
+        a[i] = 1.0f + 0.25f * static_cast<float>(i);
+    const auto a6 = math::pow<6>(a);
+    for (size_t i = 0; i < a.size(); ++i)
+        ASSERT_FLOAT_EQ(a6[i], std::pow(a[i], 6.0f));
+
+}
+
+
+TEST_F(QuantityTest, RationalRoots) {
+
+    // rational powers of the bases, reduced so that the roots compose back
+    using sqrt_hz = math::root_t<2, unit<basis::frequency>>;
+    using density = math::divide_t<units::meter, sqrt_hz>;
+    static_assert(math::root_t<2, basis::length>::den == 2 && math::root_t<2, basis::length>::powers[0] == 1);
+    static_assert(std::is_same_v<math::square_t<math::root_t<2, basis::length>>, basis::length>);
+    static_assert(std::is_same_v<math::multiply_t<math::root_t<3, basis::area>, math::root_t<3, basis::length>>, basis::length>);
+    static_assert(unit_label_v<density>.compare("m s^1/2") == 0);
+    static_assert(unit_label_v<math::root_t<-2, unit<basis::area, std::micro>>>.compare("(k)m^-1") == 0);
+
+    // exact prefixes
+    static_assert(std::is_same_v<math::root_t<2, std::mega>, std::kilo>);
+    static_assert(std::is_same_v<math::root_t<3, std::ratio<27, 1000000000>>, std::ratio<3, 1000>>);
+    static_assert(std::is_same_v<math::root_t<-2, std::ratio<1, 4>>, std::ratio<2>>);
+    ASSERT_THROW(rational::of<std::kilo>().root(2), std::domain_error);
+
+    // numbers, with square and cube roots
+    ASSERT_DOUBLE_EQ(math::rsqrt(4.0), 0.5);
+    ASSERT_DOUBLE_EQ(math::cbrt(27.0), 3.0);
+    ASSERT_DOUBLE_EQ(math::root<6>(64.0), 2.0);
+    ASSERT_DOUBLE_EQ(math::root<5>(32.0), 2.0);
+    ASSERT_EQ(math::root<2>(49), 7);
+
+    // an amplitude spectral density, from a column through the kernels
+    std::vector<double> psd(37);
+    for (size_t i = 0; i < psd.size(); ++i)
+        psd[i] = 1.0 + 0.5 * static_cast<double>(i);
+    const quantity<std::vector<double>, math::divide_t<unit<basis::area>, unit<basis::frequency>>> p(psd);
+    const quantity<std::vector<double>, density> asd = math::sqrt(p);
+    const quantity<std::vector<double>, math::invert_t<density>> inv_asd = math::rsqrt(p);
+    for (size_t i = 0; i < psd.size(); ++i) {
+        ASSERT_DOUBLE_EQ(asd.value[i], std::sqrt(psd[i]));
+        ASSERT_DOUBLE_EQ(inv_asd.value[i], 1.0 / std::sqrt(psd[i]));
+    }
+
+    std::array<float, 19> a{};
+    for (size_t i = 0; i < a.size(); ++i)
+        a[i] = 1.0f + 0.25f * static_cast<float>(i);
+    const auto a4 = math::root<-4>(a);
+    for (size_t i = 0; i < a.size(); ++i)
+        ASSERT_FLOAT_EQ(a4[i], 1.0f / std::sqrt(std::sqrt(a[i])));
+
+    // rational powers known at runtime
+    dynamic_unit u;
+    ASSERT_EQ(read_unit_label("(k)m Hz^-1/2", u), std::errc::invalid_argument);
+    ASSERT_EQ(read_unit_label("(k)m s^1/2 s^1/2", u), std::errc{});
+    ASSERT_TRUE((u == dynamic_unit::of<unit<math::multiply_t<basis::length, basis::time>, std::kilo>>()));
+    ASSERT_EQ(read_unit_label("(M)m^2 s^1/3", u), std::errc{});
+    ASSERT_TRUE((u.root(2) == dynamic_unit::of<unit<math::multiply_t<basis::length, math::root_t<6, basis::time>>, std::kilo>>()));
+    ASSERT_THROW(u.root(4), std::domain_error);
+    const dynamic_quantity<double> area(9.0, dynamic_unit::of<unit<basis::area, std::mega>>());
+    ASSERT_DOUBLE_EQ(math::sqrt(area).value, 3.0);
+    ASSERT_TRUE(math::sqrt(area).is<unit<basis::length>>());
+    EXPECT_THROW(math::sqrt(dynamic_quantity<double>(quantity<double, unit<basis::length, std::kilo>>(4.0))), std::domain_error);
+
+}
+
+
+TEST_F(QuantityTest, DynamicQuantity) {
+
+    using km = unit<basis::length, std::kilo>;
+
+    const dynamic_quantity<double> d = quantity<double, cm>(250.0);
+    const dynamic_quantity<double> t = quantity<double, s>(2.0);
+    ASSERT_TRUE(d.is<km>());
+    ASSERT_FALSE(d.is<s>());
+    ASSERT_DOUBLE_EQ(d.as<cm>().value, 250.0);
+    ASSERT_DOUBLE_EQ(d.as<km>().value, 0.0025);
+    ASSERT_THROW(d.as<s>(), std::runtime_error);
+
+    // the dimensions are checked at runtime, the sum is in the unit of the first operand
+    const auto sum = d + dynamic_quantity<double>(quantity<double, km>(1.0));
+    ASSERT_DOUBLE_EQ(sum.value, 100250.0);
+    ASSERT_THROW(d + t, std::runtime_error);
+    ASSERT_DOUBLE_EQ((d - d).value, 0.0);
+
+    const auto v = d / t;
+    ASSERT_TRUE(v.is<unit<basis::velocity>>());
+    ASSERT_DOUBLE_EQ(v.as<unit<basis::velocity>>().value, 1.25);
+    ASSERT_TRUE((v * t).is<cm>());
+    ASSERT_TRUE((math::pow<2>(v).is<math::square_t<unit<basis::velocity>>>()));
+    ASSERT_TRUE(math::inv(t).is<math::invert_t<s>>());
+    ASSERT_DOUBLE_EQ((2.0 * d / 4.0).value, 125.0);
+
+    // packed powers and exact prefixes
+    static_assert(dimension::of<basis::velocity>().power(0) == 1 && dimension::of<basis::velocity>().power(1) == -1);
+    static_assert((dynamic_unit::of<cm>() * dynamic_unit::of<km>()).prefix == rational{10, 1});
+    ASSERT_THROW(dynamic_unit::of<cm>().pow(100), std::overflow_error);
+    EXPECT_THROW(math::pow<100>(d), std::overflow_error);
+    EXPECT_THROW(math::pow<4>(dynamic_quantity<double>(1.0, {dimension{}, rational{1, 1000000000}})), std::overflow_error);
+    static_assert(noexcept(math::pow<2>(1.0)) && !noexcept(math::sq(d)));
+    ASSERT_DOUBLE_EQ(d.to(dynamic_unit::of<unit<basis::length, std::milli>>()).value, 2500.0);
+
+    // integers are scaled without overflowing before the division, and throw when the result does not fit
+    using inch = unit<basis::length, std::ratio<127, 5000>>;
+    const dynamic_quantity<int64_t> far = quantity<int64_t, inch>(int64_t(1) << 60);
+    ASSERT_EQ(far.as<units::meter>().value, (int64_t(1) << 60) / 5000 * 127 + (int64_t(1) << 60) % 5000 * 127 / 5000);
+    ASSERT_EQ((dynamic_quantity<int>(quantity<int, cm>(3)).as<unit<basis::length, std::milli>>().value), 30);
+    ASSERT_EQ(dynamic_quantity<int>(quantity<int, cm>(7)).as<units::meter>().value, 0);
+    ASSERT_THROW((dynamic_quantity<int>(quantity<int, unit<basis::length, std::tera>>(1)).as<units::meter>()), std::overflow_error);
+
+    // text round trip
+    ASSERT_EQ(to_chars_string(v).compare("125 (c)m s^-1"), 0);
+    dynamic_quantity<double> parsed;
+    const std::string_view text = "9.81 (1/3)m s^-2";
+    const auto r = from_chars(text.data(), text.data() + text.size(), parsed);
+    ASSERT_EQ(r.ec, std::errc{});
+    ASSERT_TRUE(r.ptr == text.data() + text.size());
+    ASSERT_TRUE((parsed.unit.prefix == rational{1, 3}));
+    ASSERT_NEAR(parsed.as<unit<basis::acceleration>>().value, 3.27, 1e-12);
+    const std::string_view wrong = "1 (k)furlong";
+    ASSERT_EQ(from_chars(wrong.data(), wrong.data() + wrong.size(), parsed).ec, std::errc::invalid_argument);
+
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -7,37 +7,98 @@
  */
 
 
+#include <gtest/gtest.h>
+
 #include "ctda.hpp"
-#include <iostream>
 
 using namespace ctda;
 
 
-int main() {
+class MeasurementTest : public ::testing::Test {
+protected:
+    using length = quantity<double, units::meter>;
+};
+
+
+TEST_F(MeasurementTest, Scalar) {
+
+    const length q(1);
+    const measurement<length> m(q.value, 0.1);
+
+    static_assert(are_same_quantity_v<length, length>);
+    static_assert(are_same_quantity_v<length, length, length>);
+
+    ASSERT_DOUBLE_EQ((q + q).value, 2.0);
+
+    const auto y = m + m;
+    ASSERT_DOUBLE_EQ(y.value().value, 2.0);
+    ASSERT_DOUBLE_EQ(y.uncertainty().value, 0.1 * std::sqrt(2.0));
+
+}
+
+
+TEST_F(MeasurementTest, Vector) {
+
+    const measurement_vector<length> v({1.0, 2.0, 3.0}, {0.1, 0.1, 0.2});
+    const measurement_vector<length> w({2.0, 2.0, 2.0}, {0.2, 0.1, 0.1});
+    ASSERT_EQ(v.size(), 3);
 
-    quantity<double, units::meter> q(1);
-    std::cout << q << '\n';
+    const auto sum = v + w;
+    const auto product = v * w;
+    const auto inverse = math::inv(v);
+    const auto opposite = -v;
+    static_assert(std::is_same_v<decltype(product)::unit_t, math::multiply_t<units::meter, units::meter>>);
+    static_assert(std::is_same_v<decltype(inverse)::unit_t, math::invert_t<units::meter>>);
 
-    measurement<decltype(q)> m(q.value, 0.1);
+    for (size_t i = 0; i < v.size(); ++i) {
+        ASSERT_DOUBLE_EQ(sum.val[i], v.val[i] + w.val[i]);
+        ASSERT_DOUBLE_EQ(sum.unc[i], std::hypot(v.unc[i], w.unc[i]));
+        ASSERT_DOUBLE_EQ(product.val[i], v.val[i] * w.val[i]);
+        ASSERT_DOUBLE_EQ(product.unc[i], std::hypot(w.val[i] * v.unc[i], v.val[i] * w.unc[i]));
+        ASSERT_DOUBLE_EQ(inverse.val[i], 1.0 / v.val[i]);
+        ASSERT_DOUBLE_EQ(inverse.unc[i], v.unc[i] / (v.val[i] * v.val[i]));
+        ASSERT_DOUBLE_EQ(opposite.val[i], -v.val[i]);
+        ASSERT_DOUBLE_EQ(opposite.unc[i], v.unc[i]);
+    }
+    ASSERT_DOUBLE_EQ(product[2].value().value, 6.0);
 
-    std::cout << m << '\n';
+    // the negation allocates, and may throw through the subtraction built on it
+    static_assert(!noexcept(math::neg(v)) && noexcept(math::neg(1.0)));
 
+    // the sizes are checked when the formulas are evaluated, and the error reaches the caller
+    const measurement_vector<length> shorter({1.0, 2.0}, {0.1, 0.1});
+    EXPECT_THROW((v + shorter), std::runtime_error);
+    EXPECT_THROW((v * shorter), std::runtime_error);
 
-    static_assert(are_same_quantity_v<decltype(q), decltype(q)>);
-    static_assert(are_same_quantity_v<decltype(q), decltype(q), decltype(q)>);
+}
 
-    auto x = q + q; 
-    std::cout << x << '\n';
 
-    auto y = m + m; 
-    std::cout << y.value() << '\n';
-    std::cout << y.uncertainty() << '\n';
+TEST_F(MeasurementTest, Array) {
 
-    std::cout << sizeof(x) << '\n';
-    std::cout << sizeof(y) << '\n';
+    // element-wise product of arrays, long enough for the kernel and with a tail
+    std::array<double, 11> x{}, y{};
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i] = 1.0 + static_cast<double>(i);
+        y[i] = 0.5 * static_cast<double>(i);
+    }
+    const auto xy = math::mult(x, y);
+    for (size_t i = 0; i < x.size(); ++i)
+        ASSERT_DOUBLE_EQ(xy[i], x[i] * y[i]);
 
-    std::cout << std::to_string(basis::momentum{}) << '\n';
-    
-    return 0; 
+    const measurement_array<length, 2> a({1.0, 2.0}, {0.1, 0.1});
+    const auto sum = a + a;
+    const auto square = a * a;
+    const auto inverse = math::inv(a);
+    const auto opposite = -a;
+    for (size_t i = 0; i < a.size(); ++i) {
+        ASSERT_DOUBLE_EQ(sum.val[i], 2.0 * a.val[i]);
+        ASSERT_DOUBLE_EQ(sum.unc[i], std::sqrt(2.0) * a.unc[i]);
+        ASSERT_DOUBLE_EQ(square.val[i], a.val[i] * a.val[i]);
+        ASSERT_DOUBLE_EQ(square.unc[i], std::sqrt(2.0) * a.val[i] * a.unc[i]);
+        ASSERT_DOUBLE_EQ(inverse.val[i], 1.0 / a.val[i]);
+        ASSERT_DOUBLE_EQ(inverse.unc[i], a.unc[i] / (a.val[i] * a.val[i]));
+        ASSERT_DOUBLE_EQ(opposite.val[i], -a.val[i]);
+        ASSERT_DOUBLE_EQ(opposite.unc[i], a.unc[i]);
+    }
 
-}
\ No newline at end of file
+}
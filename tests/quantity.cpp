@@ -10,6 +10,7 @@
 #include <gtest/gtest.h>
 
 #include "ctda.hpp"
+#include "ctda_io.hpp"
 
 using namespace ctda;
 using namespace units;
@@ -55,6 +56,285 @@ TEST_F(QuantityTest, QuantityConstruction) {
 }
 
 
+TEST_F(QuantityTest, QuantityConversion) {
+
+    using mm = unit<basis::length, std::milli>;
+    using km = unit<basis::length, std::kilo>;
+
+    static_assert(std::is_same_v<conversion_t<cm, mm>, std::ratio<10>>);
+    static_assert(std::is_same_v<conversion_t<mm, km>, std::ratio<1, 1000000>>);
+    static_assert(std::is_same_v<math::scale_t<std::ratio<1>, std::vector<double>>, std::vector<double>>);
+
+    constexpr auto a = quantity<double, cm>(1.0) + quantity<double, mm>(5.0);
+    static_assert(std::is_same_v<decltype(a)::unit_t, cm>);
+    ASSERT_DOUBLE_EQ(a.value, 1.5);
+
+    constexpr auto b = math::convert<mm>(quantity<int, cm>(3));
+    static_assert(b.value == 30);
+
+    ASSERT_DOUBLE_EQ(math::convert<km>(quantity<double, mm>(2.5e6)).value, 2.5);
+
+    auto c = quantity<std::vector<double>, mm>({1.0, 2.0, 3.0});
+    auto d = quantity<std::vector<double>, km>({1.0, 1.0, 1.0});
+    quantity<std::vector<double>, mm> e = c + d - c;
+    ASSERT_EQ(e.value, (std::vector<double>{1e6, 1e6, 1e6}));
+
+    using f_t = decltype(math::scale<std::ratio<1, 10>>(math::scale<std::ratio<10>>(c.value)));
+    static_assert(std::is_same_v<f_t, const std::vector<double>&>);
+
+    auto g = math::scale<std::ratio<1000>>(math::scale<std::ratio<1, 10>>(c.value));
+    static_assert(std::is_same_v<decltype(g), expression<math::scale_op<std::ratio<100>>, std::vector<double>>>);
+    ASSERT_DOUBLE_EQ(g[2], 300.0);
+
+    // an inner node cancelled out is returned by value, so it outlives the temporary expression holding it
+    auto h = math::scale<std::ratio<1, 10>>(math::scale<std::ratio<10>>(c.value + c.value));
+    static_assert(std::is_same_v<decltype(h), expression<math::add_op, std::vector<double>, std::vector<double>>>);
+    ASSERT_DOUBLE_EQ(h[2], 6.0);
+
+    // integers are scaled without overflowing before the division
+    static_assert(math::scale<std::ratio<3, 7>>(int64_t(4611686018427387903)) == 1976436865040309101);
+    static_assert(math::scale<std::ratio<3, 7>>(int64_t(-10)) == -4 && math::scale<std::ratio<3, 7>>(int8_t(100)) == 42);
+
+}
+
+
+TEST_F(QuantityTest, QuantityLayout) {
+
+    static_assert(std::is_trivially_copyable_v<quantity<double, cm>>);
+    static_assert(has_value_layout_v<quantity<double, cm>>);
+    static_assert(!has_value_layout_v<quantity<std::vector<double>, cm>>);
+    static_assert(std::is_trivially_copyable_v<measurement<quantity<float, s>>>);
+
+    std::vector<double> frame{1.0, 2.0, 3.0, 4.0};
+    auto lengths = as_quantities<cm>(std::span(frame));
+    static_assert(std::is_same_v<decltype(lengths), std::span<quantity<double, cm>>>);
+    lengths[1] += quantity<double, cm>(10.0);
+    ASSERT_EQ(frame[1], 12.0);
+    ASSERT_EQ(as_values(lengths).data(), frame.data());
+
+    std::vector<quantity<double, cm>> copy(frame.size());
+    bulk_copy(std::span<const double>(frame), std::span(copy));
+    ASSERT_EQ(copy[3].value, 4.0);
+    std::vector<double> back(frame.size());
+    bulk_copy(std::span(copy), std::span(back));
+    ASSERT_EQ(back, frame);
+
+    constexpr auto arr = as_quantities<cm>(std::array<double, 2>{1.0, 2.0});
+    static_assert(as_values(arr)[1] == 2.0);
+
+}
+
+
+TEST_F(QuantityTest, QuantityText) {
+
+    using mm = unit<basis::length, std::milli>;
+    using inch = unit<basis::length, std::ratio<127, 5000>>;
+    static_assert(unit_label_v<cm>.compare("(c)m") == 0);
+    static_assert(unit_label_v<mm>.compare("(m)m") == 0);
+    static_assert(unit_label_v<inch>.compare("(127/5000)m") == 0);
+    static_assert(unit_label_v<unit<basis::velocity, std::ratio<10000>>>.compare("(1e4)m s^-1") == 0);
+
+    char buffer[64];
+    auto r = to_chars(std::begin(buffer), std::end(buffer), quantity<double, cm>(1.5));
+    ASSERT_EQ(r.ec, std::errc{});
+    ASSERT_EQ(std::string_view(buffer, r.ptr), "1.5 (c)m");
+
+    r = to_chars(buffer, buffer + 4, quantity<double, cm>(1.5));
+    ASSERT_EQ(r.ec, std::errc::value_too_large);
+
+    ASSERT_EQ(std::to_string(measurement<quantity<double, s>>(2.0, 0.25)), "2 s +- 0.25 s");
+    ASSERT_EQ(std::to_string(quantity<std::array<double, 3>, s>({1.0, 0.5, 3.0})), "[1 0.5 3] s");
+
+    const quantity<std::vector<double>, cm> column({0.1, 2.0, -3.25});
+    r = write_column(buffer, column, ',');
+    ASSERT_EQ(r.ec, std::errc{});
+    ASSERT_EQ(std::string_view(buffer, r.ptr), "0.1,2,-3.25,");
+
+    r = write_column(std::span(buffer, 6), column, ',');
+    ASSERT_EQ(r.ec, std::errc::value_too_large);
+    ASSERT_EQ(std::string_view(buffer, r.ptr), "0.1,2,");
+
+}
+
+
+#ifdef __cpp_lib_format
+
+TEST_F(QuantityTest, QuantityFormat) {
+
+    ASSERT_EQ(std::format("{}", quantity<double, cm>(1.5)), "1.5 (c)m");
+    ASSERT_EQ(std::format("{:.2f}", quantity<double, cm>(1.5)), "1.50 (c)m");
+    ASSERT_EQ(std::format("{:>6}|", quantity<double, s>(2.0)), "     2 s|");
+    ASSERT_EQ(std::format("{:.1f}", measurement<quantity<double, s>>(2.0, 0.5)), "2.0 s +- 0.5 s");
+    ASSERT_EQ(std::format("{}", quantity<std::array<double, 3>, s>({1.0, 0.5, 3.0})), "[1 0.5 3] s");
+    ASSERT_EQ(std::format("{}", cm{}), "(c)m");
+
+    // the measurement is written after the text before it, not over it
+    std::string text = "x = ";
+    std::format_to(std::back_inserter(text), "{}", measurement<quantity<double, s>>(2.0, 0.25));
+    ASSERT_EQ(text, "x = 2 s +- 0.25 s");
+
+}
+
+#endif
+
+
+TEST_F(QuantityTest, QuantityParse) {
+
+    using m_s = unit<basis::velocity>;
+    using m_s2 = unit<basis::acceleration>;
+
+    const std::string_view speed = "1.25 (k)m s^-1";
+    quantity<double, m_s> v;
+    auto r = from_chars(speed.data(), speed.data() + speed.size(), v);
+    ASSERT_EQ(r.ec, std::errc{});
+    ASSERT_EQ(r.ptr, speed.data() + speed.size());
+    ASSERT_DOUBLE_EQ(v.value, 1250.0);
+
+    const std::string_view wrong = "1.25 m s^-2";
+    r = from_chars(wrong.data(), wrong.data() + wrong.size(), v);
+    ASSERT_EQ(r.ec, std::errc::invalid_argument);
+
+    const std::string_view g = "9.81 +- 0.02 m s^-2";
+    measurement<quantity<double, m_s2>> a(0.0);
+    r = from_chars(g.data(), g.data() + g.size(), a);
+    ASSERT_EQ(r.ec, std::errc{});
+    ASSERT_DOUBLE_EQ(a.value().value, 9.81);
+    ASSERT_DOUBLE_EQ(a.uncertainty().value, 0.02);
+
+    const std::string written = std::to_string(measurement<quantity<double, cm>>(2.5, 0.5));
+    measurement<quantity<double, unit<basis::length, std::milli>>> b(0.0);
+    r = from_chars(written.data(), written.data() + written.size(), b);
+    ASSERT_EQ(r.ec, std::errc{});
+    ASSERT_DOUBLE_EQ(b.value().value, 25.0);
+    ASSERT_DOUBLE_EQ(b.uncertainty().value, 5.0);
+
+    const std::string_view log = "1 (c)m\n2.5 (c)m\n\n0.5 m\n3\n4 s\n";
+    std::array<quantity<double, cm>, 8> column{};
+    const auto c = parse_column(log, std::span(column));
+    ASSERT_EQ(c.ec, std::errc::invalid_argument);
+    ASSERT_EQ(c.count, 4);
+    ASSERT_EQ(column[1].value, 2.5);
+    ASSERT_DOUBLE_EQ(column[2].value, 50.0);
+    ASSERT_EQ(column[3].value, 3.0);
+
+    const auto full = parse_column(log.substr(0, 10), std::span(column).first(2));
+    ASSERT_EQ(full.ec, std::errc{});
+    ASSERT_EQ(full.count, 2);
+
+    // a line in the unit of the column does not lose the factor of the label kept
+    const std::string_view mixed = "1 (k)m\n2 m\n3 (k)m\n";
+    std::array<quantity<double, units::meter>, 3> metres{};
+    const auto m = parse_column(mixed, std::span(metres));
+    ASSERT_EQ(m.ec, std::errc{});
+    ASSERT_EQ(m.count, 3);
+    ASSERT_DOUBLE_EQ(metres[0].value, 1000.0);
+    ASSERT_DOUBLE_EQ(metres[1].value, 2.0);
+    ASSERT_DOUBLE_EQ(metres[2].value, 3000.0);
+
+}
+
+
+TEST_F(QuantityTest, QuantityBinary) {
+
+    const auto path = std::filesystem::temp_directory_path().append("ctda_quantity_binary.bin");
+
+    const quantity<std::vector<double>, cm> lengths(std::vector<double>{1.0, 2.5, -3.0});
+    save(path, lengths);
+
+    {
+        const mapped_column<quantity<double, cm>> column(path);
+        ASSERT_EQ(column.size(), 3);
+        ASSERT_EQ(column[1].value, 2.5);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(column.value().value.data()) % binary_header::alignment, 0);
+        const quantity<std::vector<double>, cm> twice = column.value() + column.value();
+        ASSERT_EQ(twice.value[2], -6.0);
+        ASSERT_EQ(column.quantities()[0].value, 1.0);
+    }
+
+    using seconds_t = mapped_column<quantity<double, s>>;
+    using floats_t = mapped_column<quantity<float, cm>>;
+    using measurements_t = mapped_column<measurement<quantity<double, cm>>>;
+    ASSERT_THROW(seconds_t{path}, std::runtime_error);
+    ASSERT_THROW(floats_t{path}, std::runtime_error);
+    ASSERT_THROW(measurements_t{path}, std::runtime_error);
+
+    save(path, measurement_vector<quantity<double, s>>({1.0, 2.0}, {0.1, 0.2}));
+    const mapped_column<measurement<quantity<double, s>>> times(path);
+    ASSERT_EQ(times.size(), 2);
+    ASSERT_EQ(times[1].value().value, 2.0);
+    ASSERT_EQ(times.uncertainty().value[0], 0.1);
+
+    // a count whose size in bytes wraps around is rejected as a truncated file
+    {
+        const binary_header crafted = binary_header::of<double, cm>((size_t(1) << 61) + 3);
+        const std::array<double, 8> values{};
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&crafted), sizeof(crafted));
+        file.write(reinterpret_cast<const char*>(values.data()), sizeof(values));
+    }
+    ASSERT_THROW((mapped_column<quantity<double, cm>>{path}), std::runtime_error);
+
+    // a file written with the other byte order is reported as such, not as a file of another unit
+    {
+        binary_header swapped = binary_header::of<double, cm>(8);
+        swapped.endian = 0x0201;
+        const std::array<double, 8> values{};
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&swapped), sizeof(swapped));
+        file.write(reinterpret_cast<const char*>(values.data()), sizeof(values));
+    }
+    try {
+        const mapped_column<quantity<double, cm>> column(path);
+        FAIL();
+    } catch (const std::runtime_error& e) {
+        ASSERT_NE(std::string_view(e.what()).find("byte order"), std::string_view::npos);
+    }
+
+    std::filesystem::remove(path);
+
+}
+
+
+TEST_F(QuantityTest, QuantityView) {
+
+    std::vector<double> frame{1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    const std::array<double, 6> offsets{0.5, 0.5, 0.5, 1.0, 1.0, 1.0};
+    std::vector<double> output(6);
+
+    const auto x = as_view<cm>(frame);
+    const auto dx = as_view<cm>(offsets);
+    static_assert(std::is_same_v<decltype(x), const quantity_view<double, cm>>);
+    static_assert(std::is_same_v<decltype(dx), const quantity_view<const double, cm>>);
+
+    auto out = as_view<cm>(output);
+    out = x + dx;
+    ASSERT_EQ(output[3], 5.0);
+    out = x * 2.0 - dx;
+    ASSERT_EQ(output[5], 11.0);
+
+    auto y = as_view<cm>(frame);
+    y -= dx;
+    y *= 2.0;
+    ASSERT_EQ(frame[0], 1.0);
+
+    quantity<std::vector<double>, cm> owner(std::vector<double>(6, 1.0));
+    as_view(owner) = x / 2.0;
+    ASSERT_EQ(owner.value[1], 1.5);
+
+    const auto m = as_mdview<cm>(frame.data(), 2, 3);
+    static_assert(std::is_same_v<std::remove_const_t<decltype(m)>, quantity_mdview<double, cm, 2>>);
+    ASSERT_EQ((m.value[1, 2]), 10.0);
+    ASSERT_EQ(m.value[1][0], 6.0);
+    ASSERT_EQ(m.value.stride(0), 3);
+
+    auto n = as_mdview<cm>(output.data(), 2, 3);
+    flat(n) = flat(m) + x;
+    ASSERT_EQ((n.value[1, 1]), 16.0);
+    ASSERT_EQ(std::to_string(m), "[[1 3 5]\n[6 8 10]] (c)m");
+
+}
+
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,172 @@
+/**
+ * @file    tests/statistics.cpp
+ * @author  Lorenzo Liuzzo (lorenzoliuzzo@outlook.com)
+ * @brief   This file contains a test for the streaming 'accumulator' struct.
+ * @date    2023-11-17
+ * @copyright Copyright (c) 2023
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "ctda.hpp"
+#include "ctda_propagation.hpp"
+#include "ctda_monte_carlo.hpp"
+
+using namespace ctda;
+using namespace units;
+
+
+class StatisticsTest : public testing::Test {
+protected:
+    using mm = unit<basis::length, std::milli>;
+    using column = std::vector<double>;
+};
+
+
+TEST_F(StatisticsTest, Welford) {
+
+    math::accumulator<quantity<double, meter>> acc;
+    for (double x : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0})
+        acc.push(quantity<double, meter>(1e9 + x));
+
+    ASSERT_EQ(acc.count(), 8);
+    ASSERT_DOUBLE_EQ(acc.mean().value, 1e9 + 5.0);
+    ASSERT_NEAR(acc.variance().value, 32.0 / 7.0, 1e-6);
+
+    measurement<quantity<double, meter>> m = acc;
+    ASSERT_NEAR(m.unc, std::sqrt(32.0 / 56.0), 1e-6);
+
+}
+
+
+TEST_F(StatisticsTest, BatchAndMerge) {
+
+    const size_t n = 10001;
+    column samples(n);
+    for (size_t i = 0; i < n; ++i)
+        samples[i] = 100.0 + static_cast<double>(i % 17) - 8.0;
+
+    math::accumulator<quantity<double, meter>> online, batch, left, right;
+    for (double x : samples)
+        online.push(quantity<double, meter>(x));
+
+    batch.push(quantity<column, meter>(samples));
+    ASSERT_EQ(batch.count(), n);
+    ASSERT_NEAR(batch.mean().value, online.mean().value, 1e-9);
+    ASSERT_NEAR(batch.variance().value, online.variance().value, 1e-9);
+
+    const auto half = std::span<const double>(samples).first(n / 2);
+    const auto rest = std::span<const double>(samples).subspan(n / 2);
+    left.push(quantity<std::span<const double>, meter>(half));
+    right.push(quantity<std::span<const double>, meter>(rest));
+    left.merge(right);
+    ASSERT_EQ(left.count(), n);
+    ASSERT_NEAR(left.mean().value, online.mean().value, 1e-9);
+    ASSERT_NEAR(left.variance().value, online.variance().value, 1e-9);
+
+    math::accumulator<quantity<double, mm>> millis;
+    millis.push(quantity<column, meter>(samples));
+    ASSERT_NEAR(millis.mean().value, 1e3 * online.mean().value, 1e-6);
+    ASSERT_NEAR(millis.stddev().value, 1e3 * online.stddev().value, 1e-6);
+
+}
+
+
+TEST_F(StatisticsTest, CorrelatedPropagation) {
+
+    using length = correlated<quantity<double, meter>>;
+
+    const source_id calibration = error_sources::declare("ruler calibration");
+    ASSERT_EQ(error_sources::declare("ruler calibration"), calibration);
+    ASSERT_EQ(error_sources::name(calibration).compare("ruler calibration"), 0);
+
+    const length a(2.0, 0.1, calibration);
+    const length zero = a - a;
+    ASSERT_EQ(zero.value().value, 0.0);
+    ASSERT_EQ(zero.uncertainty().value, 0.0);
+    ASSERT_TRUE(zero.sources().empty());
+
+    // two channels sharing the calibration and reading with independent errors
+    const length x = a + length(1.0, 0.3, error_sources::declare());
+    const length y = a + length(1.0, 0.4, error_sources::declare());
+    ASSERT_NEAR(x.uncertainty().value, std::sqrt(0.01 + 0.09), 1e-12);
+    ASSERT_NEAR(math::covariance(x, y).value, 0.01, 1e-12);
+    ASSERT_NEAR(math::correlation(x, y), 0.01 / std::sqrt(0.10 * 0.17), 1e-12);
+    ASSERT_NEAR((x - y).uncertainty().value, std::sqrt(0.09 + 0.16), 1e-12);
+    ASSERT_NEAR((measurement<quantity<double, meter>>(x + y).unc), std::sqrt(0.04 + 0.09 + 0.16), 1e-12);
+
+    const auto area = x * y;
+    static_assert(std::is_same_v<decltype(area)::unit_t, math::square_t<meter>>);
+    ASSERT_NEAR(area.contribution(calibration).value, 0.1 * (3.0 + 3.0), 1e-12);
+
+    const auto ratio = x / y;
+    static_assert(std::is_same_v<decltype(ratio)::unit_t::base_t, basis::dimensionless>);
+    ASSERT_EQ(ratio.contribution(calibration).value, 0.0);
+    ASSERT_NEAR(ratio.uncertainty().value, std::sqrt(0.09 + 0.16) / 3.0, 1e-12);
+
+    const auto scaled = 2.0 * quantity<double, second>(3.0) * a / quantity<double, second>(6.0);
+    ASSERT_NEAR(scaled.value().value, 2.0, 1e-12);
+    ASSERT_NEAR(scaled.contribution(calibration).value, 0.1, 1e-12);
+
+    const correlated<quantity<double, mm>> b(2000.0, 100.0, calibration);
+    ASSERT_NEAR((a - b).uncertainty().value, 0.0, 1e-15);
+
+    const std::array<length, 3> channels{x, y, a};
+    const auto cov = math::covariance_matrix(std::span<const length>(channels));
+    ASSERT_NEAR(cov[0], 0.10, 1e-12);
+    ASSERT_NEAR(cov[1], 0.01, 1e-12);
+    ASSERT_NEAR(cov[3], 0.01, 1e-12);
+    ASSERT_NEAR(cov[8], 0.01, 1e-12);
+
+}
+
+
+TEST_F(StatisticsTest, MonteCarlo) {
+
+    // known answers of the Philox4x32-10 generator
+    std::array<uint32_t, 64> bits;
+    math::simd::philox({0, 0}, {0, 0, 0, 0}, bits.data(), 1);
+    ASSERT_EQ(bits[0], 0x6627e8d5u);
+    ASSERT_EQ(bits[16], 0xe169c58du);
+    ASSERT_EQ(bits[32], 0xbc57ac4cu);
+    ASSERT_EQ(bits[48], 0x9b00dbd8u);
+    math::simd::philox({0xa4093822u, 0x299f31d0u}, {0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}, bits.data(), 1);
+    ASSERT_EQ(bits[0], 0xd16cfe09u);
+    ASSERT_EQ(bits[48], 0x24126ea1u);
+
+    const measurement<quantity<double, meter>> x(10.0, 0.1);
+    const measurement<quantity<double, second>> t(2.0, 0.05);
+    const auto speed = [](const auto& x, const auto& t) { return x / t; };
+
+    const size_t n = 100000;
+    const auto serial = math::monte_carlo(speed, n, 42, x, t);
+    static_assert(std::is_same_v<decltype(serial.mean())::unit_t, math::divide_t<meter, second>>);
+    ASSERT_EQ(serial.size(), n);
+    ASSERT_TRUE(std::ranges::is_sorted(serial.samples));
+    ASSERT_NEAR(serial.mean().value, 5.0, 0.005);
+    ASSERT_NEAR(serial.stddev().value, 5.0 * std::hypot(0.01, 0.025), 0.005);
+    ASSERT_NEAR(serial.median().value, 5.0, 0.005);
+
+    const auto [low, high] = serial.interval(0.6827);
+    ASSERT_NEAR((high - low).value / 2, serial.stddev().value, 0.005);
+
+    thread_pool pool(4);
+    const auto parallel = math::monte_carlo(par(pool), speed, n, 42, x, t);
+    ASSERT_TRUE(std::ranges::equal(serial.samples, parallel.samples));
+    ASSERT_FALSE(std::ranges::equal(serial.samples, math::monte_carlo(speed, n, 43, x, t).samples));
+
+    // the square of a standard normal variable follows a chi-squared distribution
+    const measurement<quantity<double, meter>> z(0.0, 1.0);
+    const measurement<quantity<double, math::square_t<meter>>> r = math::monte_carlo(par(pool), [](const auto& z) { return z * z; }, n, 7, z);
+    ASSERT_NEAR(r.val, 1.0, 0.02);
+    ASSERT_NEAR(r.unc, std::sqrt(2.0), 0.03);
+    ASSERT_NEAR(math::monte_carlo([](const auto& z) { return z * z; }, n, 7, z).median().value, 0.4549, 0.01);
+
+}
+
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}